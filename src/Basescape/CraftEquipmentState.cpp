@@ -919,7 +919,7 @@ void CraftEquipmentState::btnClearClick(Action *)
 	if (_isNewBattle)
 	{
 		Craft* c = _base->getCrafts()->at(_craft);
-		c->getItems()->getContents()->clear();
+		c->getItems()->clear();
 	}
 }
 
@@ -952,7 +952,7 @@ void CraftEquipmentState::saveGlobalLoadout(int index)
 {
 	// clear the template
 	ItemContainer *tmpl = _game->getSavedGame()->getGlobalCraftLoadout(index);
-	tmpl->getContents()->clear();
+	tmpl->clear();
 
 	Craft *c = _base->getCrafts()->at(_craft);
 	// save only what is visible on the screen (can be DIFFERENT than what's really in the craft for various reasons)
@@ -988,7 +988,7 @@ void CraftEquipmentState::loadGlobalLoadout(int index, bool onlyAddItems)
 
 	Craft* c = _base->getCrafts()->at(_craft);
 
-	ItemContainer craftItemsBackup;
+	ItemContainer craftItemsBackup(_game->getMod());
 	std::vector<Vehicle*> craftVehiclesBackup;
 	if (onlyAddItems)
 	{
@@ -1017,9 +1017,9 @@ void CraftEquipmentState::loadGlobalLoadout(int index, bool onlyAddItems)
 	// lastly check and report what's missing
 	std::string craftName = c->getName(_game->getLanguage());
 	std::vector<ReequipStat> _missingItems;
-	for (const auto& templateItem : *tmpl->getContents())
+	for (const auto& templateItem : *tmpl)
 	{
-		RuleItem *item = _game->getMod()->getItem(templateItem.first, false);
+		RuleItem *item = templateItem.first;
 		if (item)
 		{
 			int tQty = templateItem.second;
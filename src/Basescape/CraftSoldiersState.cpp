@@ -489,7 +489,7 @@ void CraftSoldiersState::lstSoldiersClick(Action *action)
 			s->setCraftAndMoveEquipment(0, _base, _game->getSavedGame()->getMonthsPassed() == -1);
 			_lstSoldiers->setCellText(row, 2, tr("STR_NONE_UC"));
 		}
-		else if (s->getCraft() && s->getCraft()->getStatus() == "STR_OUT")
+		else if (s->getCraft() && s->getCraft()->getStatusId() == CRAFT_OUT)
 		{
 			color = _otherCraftColor;
 		}
@@ -563,12 +563,12 @@ void CraftSoldiersState::btnDeassignAllSoldiersClick(Action *action)
 	for (auto* soldier : *_base->getSoldiers())
 	{
 		color = _lstSoldiers->getColor();
-		if (soldier->getCraft() && soldier->getCraft()->getStatus() != "STR_OUT")
+		if (soldier->getCraft() && soldier->getCraft()->getStatusId() != CRAFT_OUT)
 		{
 			soldier->setCraftAndMoveEquipment(0, _base, _game->getSavedGame()->getMonthsPassed() == -1);
 			_lstSoldiers->setCellText(row, 2, tr("STR_NONE_UC"));
 		}
-		else if (soldier->getCraft() && soldier->getCraft()->getStatus() == "STR_OUT")
+		else if (soldier->getCraft() && soldier->getCraft()->getStatusId() == CRAFT_OUT)
 		{
 			color = _otherCraftColor;
 		}
@@ -157,7 +157,7 @@ void CraftsState::lstCraftsClick(Action *action)
 
 	if (_game->isLeftClick(action))
 	{
-		if (crafts[row]->getStatus() != "STR_OUT")
+		if (crafts[row]->getStatusId() != CRAFT_OUT)
 		{
 			_game->pushState(new CraftInfoState(_base, row));
 		}
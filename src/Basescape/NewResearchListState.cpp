@@ -271,7 +271,6 @@ void NewResearchListState::fillProjectList(bool markAllAsSeen)
 	}
 	auto researchRuleIt = _projects.begin();
 	RuleResearch* rule = nullptr;
-	int row = 0;
 	bool hasUnseen = false;
 	while (researchRuleIt != _projects.end())
 	{
@@ -315,7 +314,6 @@ void NewResearchListState::fillProjectList(bool markAllAsSeen)
 		//  - for now, handling "requires" via zero-cost helpers (e.g. STR_LEADER_PLUS)... is enough
 		if (rule->getRequirements().empty())
 		{
-			_lstResearch->addRow(1, tr(rule->getName()).c_str());
 			if (markAllAsSeen)
 			{
 				// mark all (new) research items as normal
@@ -323,10 +321,8 @@ void NewResearchListState::fillProjectList(bool markAllAsSeen)
 			}
 			else if (_game->getSavedGame()->isResearchRuleStatusNew(rule->getName()))
 			{
-				_lstResearch->setRowColor(row, _colorNew);
 				hasUnseen = true;
 			}
-			row++;
 			++researchRuleIt;
 		}
 		else
@@ -335,6 +331,8 @@ void NewResearchListState::fillProjectList(bool markAllAsSeen)
 		}
 	}
 
+	_lstResearch->setRowProvider(this, (TextListRowProvider)&NewResearchListState::provideProjectRow, _projects.size());
+
 	std::string label = tr("STR_SHOW_ONLY_NEW");
 	_btnShowOnlyNew->setText((hasUnseen ? "* " : "") + label);
 	if (_lstScroll > 0)
@@ -344,4 +342,20 @@ void NewResearchListState::fillProjectList(bool markAllAsSeen)
 	}
 }
 
+/**
+ * Fills a single row of the project list, the list
+ * only asks for rows that are about to be shown.
+ * @param row Row number.
+ * @param cells Texts of the row.
+ */
+void NewResearchListState::provideProjectRow(size_t row, std::vector<Text*> &cells)
+{
+	const std::string &name = _projects[row]->getName();
+	cells[0]->setText(tr(name));
+	if (_game->getSavedGame()->isResearchRuleStatusNew(name))
+	{
+		cells[0]->setColor(_colorNew);
+	}
+}
+
 }
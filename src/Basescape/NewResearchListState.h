@@ -70,6 +70,8 @@ public:
 	void btnMarkAllAsSeenClick(Action *action);
 	/// Fills the ResearchProject list with possible ResearchProjects.
 	void fillProjectList(bool markAllAsSeen);
+	/// Fills a single row of the project list.
+	void provideProjectRow(size_t row, std::vector<Text*> &cells);
 	/// Initializes the state.
 	void init() override;
 };
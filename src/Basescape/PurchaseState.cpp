@@ -759,9 +759,9 @@ void PurchaseState::btnOkClick(Action *)
 						craftPurchaseLimitLog[rule->getType()] += 1;
 					}
 					t = new Transfer(rule->getTransferTime());
-					Craft *craft = new Craft(rule, _base, _game->getSavedGame()->getId(rule->getType()));
+					Craft *craft = new Craft(rule, _game->getMod(), _base, _game->getSavedGame()->getId(rule->getType()));
 					craft->initFixedWeapons(_game->getMod());
-					craft->setStatus("STR_REFUELLING");
+					craft->setStatus(CRAFT_REFUELLING);
 					t->setCraft(craft);
 					_base->getTransfers()->push_back(t);
 				}
@@ -82,6 +82,7 @@ void SelectStartFacilityState::btnOkClick(Action *)
 		delete fac;
 	}
 	_base->getFacilities()->clear();
+	_base->updateCapacity();
 	_game->popState();
 	_game->popState();
 	_game->pushState(new PlaceLiftState(_base, _globe, true));
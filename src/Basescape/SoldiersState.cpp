@@ -365,7 +365,7 @@ void SoldiersState::initList(size_t scrl)
 		{
 			for (auto* soldier : *_base->getSoldiers())
 			{
-				if (soldier->getCraft() && soldier->getCraft()->getStatus() == "STR_OUT")
+				if (soldier->getCraft() && soldier->getCraft()->getStatusId() == CRAFT_OUT)
 				{
 					// soldiers outside of the base are not eligible
 					continue;
@@ -457,14 +457,26 @@ void StoresState::sortList(ItemSort sort)
  */
 void StoresState::updateList()
 {
-	for (const auto& item : _itemList)
-	{
-		std::ostringstream ss, ss2, ss3;
-		ss << item.quantity;
-		ss2 << item.size;
-		ss3 << item.spaceUsed;
-		_lstStores->addRow(4, item.name.c_str(), ss.str().c_str(), ss2.str().c_str(), ss3.str().c_str());
-	}
+	_lstStores->setRowProvider(this, (TextListRowProvider)&StoresState::provideItemRow, _itemList.size());
+}
+
+/**
+ * Fills a single row of the item list,
+ * only called for rows that are about to be shown.
+ * @param row Row number.
+ * @param cells Texts of the row.
+ */
+void StoresState::provideItemRow(size_t row, std::vector<Text*> &cells)
+{
+	const auto& item = _itemList[row];
+	std::ostringstream ss, ss2, ss3;
+	ss << item.quantity;
+	ss2 << item.size;
+	ss3 << item.spaceUsed;
+	cells[0]->setText(item.name);
+	cells[1]->setText(ss.str());
+	cells[2]->setText(ss2.str());
+	cells[3]->setText(ss3.str());
 }
 
 /**
@@ -97,6 +97,8 @@ public:
 	void sortList(ItemSort sort);
 	/// Updates the item list.
 	virtual void updateList();
+	/// Fills a single row of the item list.
+	void provideItemRow(size_t row, std::vector<Text*> &cells);
 	/// Handler for clicking the Name arrow.
 	void sortNameClick(Action *action);
 	/// Handler for clicking the Quantity arrow.
@@ -208,14 +208,13 @@ void TechTreeSelectState::initLists()
 		for (auto& tmp : tmpList)
 		{
 			_availableTopics.push_back(tmp);
-			_lstTopics->addRow(1, tr(tmp).c_str());
-			_lstTopics->setRowColor(row, _parent->getResearchColor(tmp));
 			++row;
 		}
 		_firstManufacturingTopicIndex = row;
 		_firstFacilitiesTopicIndex = row;
 		_firstItemTopicIndex = row;
 		_firstCraftTopicIndex = row;
+		_lstTopics->setRowProvider(this, (TextListRowProvider)&TechTreeSelectState::provideTopicRow, _availableTopics.size());
 		return;
 	}
 
@@ -236,8 +235,6 @@ void TechTreeSelectState::initLists()
 		}
 
 		_availableTopics.push_back(res);
-		_lstTopics->addRow(1, tr(res).c_str());
-		_lstTopics->setRowColor(row, _parent->getResearchColor(res));
 		++row;
 	}
 
@@ -260,14 +257,6 @@ void TechTreeSelectState::initLists()
 		}
 
 		_availableTopics.push_back(manuf);
-		std::ostringstream ss;
-		ss << tr(manuf);
-		ss << tr("STR_M_FLAG");
-		_lstTopics->addRow(1, ss.str().c_str());
-		if (!_parent->isDiscoveredManufacture(manuf))
-		{
-			_lstTopics->setRowColor(row, _lstTopics->getSecondaryColor());
-		}
 		++row;
 	}
 
@@ -290,14 +279,6 @@ void TechTreeSelectState::initLists()
 		}
 
 		_availableTopics.push_back(facType);
-		std::ostringstream ss;
-		ss << tr(facType);
-		ss << tr("STR_F_FLAG");
-		_lstTopics->addRow(1, ss.str().c_str());
-		if (!_parent->isDiscoveredFacility(facType))
-		{
-			_lstTopics->setRowColor(row, _lstTopics->getSecondaryColor());
-		}
 		++row;
 	}
 
@@ -325,14 +306,6 @@ void TechTreeSelectState::initLists()
 		}
 
 		_availableTopics.push_back(itemType);
-		std::ostringstream ss;
-		ss << tr(itemType);
-		ss << tr("STR_I_FLAG");
-		_lstTopics->addRow(1, ss.str().c_str());
-		if (!_parent->isProtectedAndDiscoveredItem(itemType))
-		{
-			_lstTopics->setRowColor(row, _lstTopics->getSecondaryColor());
-		}
 		++row;
 	}
 
@@ -355,16 +328,56 @@ void TechTreeSelectState::initLists()
 		}
 
 		_availableTopics.push_back(craftType);
-		std::ostringstream ss;
-		ss << tr(craftType);
-		ss << tr("STR_C_FLAG");
-		_lstTopics->addRow(1, ss.str().c_str());
-		if (!_parent->isDiscoveredCraft(craftType))
-		{
-			_lstTopics->setRowColor(row, _lstTopics->getSecondaryColor());
-		}
 		++row;
 	}
+
+	_lstTopics->setRowProvider(this, (TextListRowProvider)&TechTreeSelectState::provideTopicRow, _availableTopics.size());
+}
+
+/**
+ * Fills a single row of the topic list, the list
+ * only asks for rows that are about to be shown.
+ * @param row Row number.
+ * @param cells Texts of the row.
+ */
+void TechTreeSelectState::provideTopicRow(size_t row, std::vector<Text*> &cells)
+{
+	const std::string &topic = _availableTopics[row];
+	if (row < _firstManufacturingTopicIndex)
+	{
+		cells[0]->setText(tr(topic));
+		cells[0]->setColor(_parent->getResearchColor(topic));
+		return;
+	}
+
+	std::ostringstream ss;
+	ss << tr(topic);
+	bool discovered;
+	if (row >= _firstCraftTopicIndex)
+	{
+		ss << tr("STR_C_FLAG");
+		discovered = _parent->isDiscoveredCraft(topic);
+	}
+	else if (row >= _firstItemTopicIndex)
+	{
+		ss << tr("STR_I_FLAG");
+		discovered = _parent->isProtectedAndDiscoveredItem(topic);
+	}
+	else if (row >= _firstFacilitiesTopicIndex)
+	{
+		ss << tr("STR_F_FLAG");
+		discovered = _parent->isDiscoveredFacility(topic);
+	}
+	else
+	{
+		ss << tr("STR_M_FLAG");
+		discovered = _parent->isDiscoveredManufacture(topic);
+	}
+	cells[0]->setText(ss.str());
+	if (!discovered)
+	{
+		cells[0]->setColor(_lstTopics->getSecondaryColor());
+	}
 }
 
 /**
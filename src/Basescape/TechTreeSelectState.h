@@ -47,6 +47,8 @@ private:
 	size_t _firstItemTopicIndex;
 	size_t _firstCraftTopicIndex;
 	void initLists();
+	/// Fills a single row of the topic list.
+	void provideTopicRow(size_t row, std::vector<Text*> &cells);
 	void onSelectTopic(Action *action);
 public:
 	/// Creates the TechTreeSelect state.
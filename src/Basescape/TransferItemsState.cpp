@@ -151,7 +151,7 @@ TransferItemsState::TransferItemsState(Base *baseFrom, Base *baseTo, DebriefingS
 	for (auto* craft : *_baseFrom->getCrafts())
 	{
 		if (_debriefingState) break;
-		if (craft->getStatus() != "STR_OUT" || (Options::canTransferCraftsWhileAirborne && craft->getFuel() >= craft->getFuelLimit(_baseTo)))
+		if (craft->getStatusId() != CRAFT_OUT || (Options::canTransferCraftsWhileAirborne && craft->getFuel() >= craft->getFuelLimit(_baseTo)))
 		{
 			TransferRow row = { TRANSFER_CRAFT, craft, craft->getName(_game->getLanguage()),  (int)(25 * _distance), 1, 0, 0, -3, 0, 0, (int)(25 * _distance) };
 			_items.push_back(row);
@@ -541,7 +541,7 @@ void TransferItemsState::completeTransfer()
 					{
 						soldier->setPsiTraining(false);
 						soldier->setTraining(false);
-						if (craft->getStatus() == "STR_OUT")
+						if (craft->getStatusId() == CRAFT_OUT)
 						{
 							_baseTo->getSoldiers()->push_back(soldier);
 						}
@@ -561,7 +561,7 @@ void TransferItemsState::completeTransfer()
 
 				// Transfer craft
 				_baseFrom->removeCraft(craft, false);
-				if (craft->getStatus() == "STR_OUT")
+				if (craft->getStatusId() == CRAFT_OUT)
 				{
 					bool returning = (craft->getDestination() == (Target*)craft->getBase());
 					_baseTo->getCrafts()->push_back(craft);
@@ -887,7 +887,7 @@ void TransferItemsState::increaseByValue(int change)
 			_pQty += craft->getNumTotalSoldiers();
 			_iQty += craft->getTotalItemStorageSize(_game->getMod());
 			getRow().amount++;
-			if (!Options::canTransferCraftsWhileAirborne || craft->getStatus() != "STR_OUT")
+			if (!Options::canTransferCraftsWhileAirborne || craft->getStatusId() != CRAFT_OUT)
 				_total += getRow().cost;
 			break;
 		case TRANSFER_ITEM:
@@ -970,7 +970,7 @@ void TransferItemsState::decreaseByValue(int change)
 		break;
 	}
 	getRow().amount -= change;
-	if (!Options::canTransferCraftsWhileAirborne || 0 == craft || craft->getStatus() != "STR_OUT")
+	if (!Options::canTransferCraftsWhileAirborne || 0 == craft || craft->getStatusId() != CRAFT_OUT)
 		_total -= getRow().cost * change;
 	updateItemStrings();
 }
@@ -21,6 +21,7 @@
 #include "AIModule.h"
 #include "../Savegame/BattleItem.h"
 #include "../Savegame/Node.h"
+#include "../Savegame/NodeIndex.h"
 #include "../Savegame/SavedBattleGame.h"
 #include "../Savegame/SavedGame.h"
 #include "TileEngine.h"
@@ -34,6 +35,7 @@
 #include "../Mod/Mod.h"
 #include "../Mod/RuleItem.h"
 #include "../fmath.h"
+#include "BattleBenchmark.h"
 
 namespace OpenXcom
 {
@@ -199,6 +201,7 @@ void AIModule::dont_think(BattleAction *action)
  */
 void AIModule::think(BattleAction *action)
 {
+	BattleBenchmark::Section section(BENCH_AI);
 	action->type = BA_RETHINK;
 	action->actor = _unit;
 	action->weapon = _unit->getMainHandWeapon(false);
@@ -546,20 +549,29 @@ void AIModule::setupPatrol()
 	{
 		// assume closest node as "from node"
 		// on same level to avoid strange things, and the node has to match unit size or it will freeze
-		int closest = 1000000;
-		for (auto* node : *_save->getNodes())
-		{
-			if (node->isDummy())
-			{
-				continue;
+		// search a growing area until the closest node found can't have a closer one outside it
+		const NodeIndex &nodeIndex = _save->getNodeIndex();
+		const int mapSize = std::max(_save->getMapSizeX(), _save->getMapSizeY());
+		std::vector<int> nearby;
+		for (int radius = 10; ; radius *= 2)
+		{
+			int closest = 1000000;
+			_fromNode = 0;
+			nodeIndex.query(_unit->getPosition(), radius, true, nearby);
+			for (int i : nearby)
+			{
+				Node *node = _save->getNodes()->at(i);
+				int d = Position::distanceSq(_unit->getPosition(), node->getPosition());
+				if (d < closest
+					&& (!(node->getType() & Node::TYPE_SMALL) || _unit->getArmor()->getSize() == 1))
+				{
+					_fromNode = node;
+					closest = d;
+				}
 			}
-			int d = Position::distanceSq(_unit->getPosition(), node->getPosition());
-			if (_unit->getPosition().z == node->getPosition().z
-				&& d < closest
-				&& (!(node->getType() & Node::TYPE_SMALL) || _unit->getArmor()->getSize() == 1))
+			if ((_fromNode && closest <= radius * radius) || radius >= mapSize)
 			{
-				_fromNode = node;
-				closest = d;
+				break;
 			}
 		}
 	}
@@ -694,12 +706,11 @@ void AIModule::setupAmbush()
 		Position origin = _save->getTileEngine()->getSightOriginVoxel(_aggroTarget);
 
 		// we'll use node positions for this, as it gives map makers a good degree of control over how the units will use the environment.
-		for (const auto* node : *_save->getNodes())
+		std::vector<int> nearby;
+		_save->getNodeIndex().query(_unit->getPosition(), 10, true, nearby);
+		for (int i : nearby)
 		{
-			if (node->isDummy())
-			{
-				continue;
-			}
+			const Node *node = _save->getNodes()->at(i);
 			Position pos = node->getPosition();
 			Tile *tile = _save->getTile(pos);
 			if (tile == 0 || Position::distance2d(pos, _unit->getPosition()) > 10 || pos.z != _unit->getPosition().z || tile->getDangerous() ||
@@ -2781,12 +2792,11 @@ bool AIModule::getNodeOfBestEfficacy(BattleAction *action, int radius)
 	int bestScore = 2;
 	Position originVoxel = _save->getTileEngine()->getSightOriginVoxel(_unit);
 	Position targetVoxel;
-	for (const auto* node : *_save->getNodes())
+	std::vector<int> nearby;
+	_save->getNodeIndex().query(_unit->getPosition(), 20, false, nearby);
+	for (int i : nearby)
 	{
-		if (node->isDummy())
-		{
-			continue;
-		}
+		const Node *node = _save->getNodes()->at(i);
 		int dist = Position::distance2d(node->getPosition(), _unit->getPosition());
 		if (dist <= 20 && dist > radius &&
 			_save->getTileEngine()->canTargetTile(&originVoxel, _save->getTile(node->getPosition()), O_FLOOR, &targetVoxel, _unit, false))
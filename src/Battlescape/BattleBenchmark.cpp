@@ -0,0 +1,295 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "BattleBenchmark.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <yaml-cpp/yaml.h>
+#include "BattlescapeGame.h"
+#include "BattlescapeState.h"
+#include "../Engine/Exception.h"
+#include "../Engine/Game.h"
+#include "../Engine/Logger.h"
+#include "../Engine/Options.h"
+#include "../Engine/RNG.h"
+#include "../Savegame/BattleItem.h"
+#include "../Savegame/BattleUnit.h"
+#include "../Savegame/SavedBattleGame.h"
+#include "../Savegame/SavedGame.h"
+#include "../Savegame/Tile.h"
+
+namespace OpenXcom
+{
+
+bool BattleBenchmark::_enabled = false;
+int BattleBenchmark::_depth[BENCH_MAX] = { };
+uint64_t BattleBenchmark::_time[BENCH_MAX] = { };
+uint64_t BattleBenchmark::_calls[BENCH_MAX] = { };
+
+namespace
+{
+
+/// Names of the timed sections in the report.
+const char *const BenchmarkSectionNames[BENCH_MAX] = { "ai", "pathfinding", "fov", "lighting", "reaction fire", "battle states" };
+
+/// Number of engine steps after which a single turn is considered stuck.
+const int BenchmarkStepLimit = 1000000;
+
+}
+
+/**
+ * Sets up a benchmark of a saved battle.
+ * @param game Pointer to the core game, without any state.
+ * @param filename Save file name, relative to the user folder.
+ * @param turns Number of turns to play.
+ * @param seed Random seed to play with, empty to keep the one in the save.
+ */
+BattleBenchmark::BattleBenchmark(Game *game, const std::string &filename, int turns, const std::string &seed) : _game(game), _filename(filename), _turns(turns), _seed(seed)
+{
+}
+
+/**
+ * Gets a monotonic timestamp.
+ * @return Time in nanoseconds.
+ */
+uint64_t BattleBenchmark::now()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * Leaves a timed section, counting it if it was the outermost one.
+ * @param section Section kind.
+ * @param start Time the section was entered, zero for nested sections.
+ */
+void BattleBenchmark::leave(BenchmarkSection section, uint64_t start)
+{
+	--_depth[section];
+	if (start != 0)
+	{
+		_time[section] += now() - start;
+		++_calls[section];
+	}
+}
+
+/**
+ * Hashes everything about the battle the AI can change:
+ * units, items, fire and smoke, and the random generator.
+ * @param save Pointer to the battle.
+ * @return FNV-1a hash of the battle state.
+ */
+uint64_t BattleBenchmark::hashState(SavedBattleGame *save)
+{
+	uint64_t hash = 14695981039346656037ull;
+	auto mix = [&](int64_t value)
+	{
+		for (int i = 0; i < 8; ++i)
+		{
+			hash ^= (value >> (i * 8)) & 0xFF;
+			hash *= 1099511628211ull;
+		}
+	};
+
+	mix(save->getTurn());
+	mix(save->getSide());
+	for (const auto* unit : *save->getUnits())
+	{
+		Position pos = unit->getPosition();
+		mix(unit->getId());
+		mix(pos.x);
+		mix(pos.y);
+		mix(pos.z);
+		mix(unit->getDirection());
+		mix(unit->getStatus());
+		mix(unit->getFaction());
+		mix(unit->getHealth());
+		mix(unit->getStunlevel());
+		mix(unit->getTimeUnits());
+		mix(unit->getEnergy());
+		mix(unit->getMorale());
+	}
+	for (const auto* item : *save->getItems())
+	{
+		mix(item->getId());
+		mix(item->getOwner() ? item->getOwner()->getId() : -1);
+		if (item->getTile())
+		{
+			Position pos = item->getTile()->getPosition();
+			mix(pos.x);
+			mix(pos.y);
+			mix(pos.z);
+		}
+		mix(item->getFuseTimer());
+	}
+	const TileHotData &hot = save->getTileHotData();
+	for (int i = 0; i < save->getMapSizeXYZ(); ++i)
+	{
+		mix(hot.fire[i]);
+		mix(hot.smoke[i]);
+	}
+	mix(RNG::getSeed());
+	return hash;
+}
+
+/**
+ * Prints the results of the run to the log and the console.
+ * @param total Total time in nanoseconds.
+ * @param turns Number of turns played.
+ * @param steps Number of engine steps taken.
+ * @param hash Hash of the final battle state.
+ */
+void BattleBenchmark::report(uint64_t total, int turns, int steps, uint64_t hash) const
+{
+	std::vector<std::string> lines;
+	std::ostringstream ss;
+	ss << "Benchmark of " << _filename << ": " << turns << " turns, " << steps << " steps, " << std::fixed << std::setprecision(1) << total / 1e6 << " ms";
+	lines.push_back(ss.str());
+	for (int i = 0; i < BENCH_MAX; ++i)
+	{
+		ss.str("");
+		ss << "  " << std::left << std::setw(14) << BenchmarkSectionNames[i] << std::right << std::setw(10) << _time[i] / 1e6 << " ms in " << _calls[i] << " calls";
+		lines.push_back(ss.str());
+	}
+	ss.str("");
+	ss << "  state hash " << std::hex << std::setw(16) << std::setfill('0') << hash;
+	lines.push_back(ss.str());
+
+	for (const auto& line : lines)
+	{
+		Log(LOG_INFO) << line;
+		std::cout << line << std::endl;
+	}
+}
+
+/**
+ * Loads the game data and the save, then lets the AI play
+ * the battle for the requested number of turns.
+ * @return Process exit code.
+ */
+int BattleBenchmark::run()
+{
+	try
+	{
+		Log(LOG_INFO) << "Loading data...";
+		Options::updateMods();
+		_game->loadMods();
+		_game->loadLanguages();
+	}
+	catch (std::exception &e)
+	{
+		Log(LOG_ERROR) << e.what();
+		return EXIT_FAILURE;
+	}
+
+	// the seed in the save is the whole point of a reproducible run
+	Options::newSeedOnLoad = false;
+	Options::mute = true;
+
+	SavedGame *save = new SavedGame(_game->getMod());
+	try
+	{
+		save->load(_filename, _game->getMod(), _game->getLanguage());
+	}
+	catch (Exception &e)
+	{
+		Log(LOG_ERROR) << e.what();
+		delete save;
+		return EXIT_FAILURE;
+	}
+	catch (YAML::Exception &e)
+	{
+		Log(LOG_ERROR) << e.what();
+		delete save;
+		return EXIT_FAILURE;
+	}
+	_game->setSavedGame(save);
+
+	SavedBattleGame *battle = save->getSavedBattle();
+	if (battle == 0)
+	{
+		Log(LOG_ERROR) << _filename << " is not a battlescape save.";
+		return EXIT_FAILURE;
+	}
+	if (!_seed.empty())
+	{
+		RNG::setSeed(strtoull(_seed.c_str(), 0, 10));
+	}
+
+	battle->loadMapResources(_game->getMod());
+	BattlescapeState *state = new BattlescapeState;
+	_game->pushState(state);
+	battle->setBattleState(state);
+	state->init();
+	BattlescapeGame *battleGame = battle->getBattleGame();
+	battleGame->setHeadless(true);
+
+	for (int i = 0; i < BENCH_MAX; ++i)
+	{
+		_time[i] = 0;
+		_calls[i] = 0;
+	}
+	_enabled = true;
+
+	const int firstTurn = battle->getTurn();
+	int turn = firstTurn;
+	int steps = 0, turnSteps = 0;
+	uint64_t start = now();
+	while (battle->getTurn() < firstTurn + _turns && !battleGame->isBattleFinished())
+	{
+		battleGame->think();
+		battleGame->handleState();
+		++steps;
+
+		// nobody is there to click away the screens shown during the battle
+		while (!_game->isState(state))
+		{
+			_game->popState();
+		}
+
+		if (!battleGame->isBusy())
+		{
+			battleGame->cleanupDeleted();
+			BattlescapeTally tally = battleGame->tallyUnits();
+			if (tally.liveAliens == 0 || tally.liveSoldiers == 0)
+			{
+				break;
+			}
+		}
+
+		if (turn != battle->getTurn())
+		{
+			turn = battle->getTurn();
+			turnSteps = 0;
+		}
+		else if (++turnSteps > BenchmarkStepLimit)
+		{
+			Log(LOG_ERROR) << "Turn " << turn << " did not end after " << BenchmarkStepLimit << " steps, stopping.";
+			break;
+		}
+	}
+	uint64_t total = now() - start;
+	_enabled = false;
+
+	report(total, battle->getTurn() - firstTurn, steps, hashState(battle));
+	return EXIT_SUCCESS;
+}
+
+}
@@ -0,0 +1,92 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <cstdint>
+
+namespace OpenXcom
+{
+
+class Game;
+class SavedBattleGame;
+
+/// Parts of the battle engine timed by the benchmark.
+enum BenchmarkSection { BENCH_AI, BENCH_PATHFINDING, BENCH_FOV, BENCH_LIGHTING, BENCH_REACTION_FIRE, BENCH_BATTLE_STATES, BENCH_MAX };
+
+/**
+ * Plays a saved battle without video or input, with the AI controlling
+ * every side, and reports how long the engine spent in each subsystem
+ * together with a hash of the final battle state.
+ * Same save, seed and turn count must always give the same hash.
+ */
+class BattleBenchmark
+{
+private:
+	static bool _enabled;
+	static int _depth[BENCH_MAX];
+	static uint64_t _time[BENCH_MAX];
+	static uint64_t _calls[BENCH_MAX];
+
+	Game *_game;
+	std::string _filename;
+	int _turns;
+	std::string _seed;
+
+	/// Gets the current time in nanoseconds.
+	static uint64_t now();
+	/// Leaves a timed section.
+	static void leave(BenchmarkSection section, uint64_t start);
+	/// Hashes the state of the battle.
+	static uint64_t hashState(SavedBattleGame *save);
+	/// Prints the collected timings.
+	void report(uint64_t total, int turns, int steps, uint64_t hash) const;
+public:
+	/**
+	 * Times the enclosing block while a benchmark is running.
+	 * Nested sections of the same kind are only counted once.
+	 */
+	class Section
+	{
+	private:
+		BenchmarkSection _section;
+		uint64_t _start;
+	public:
+		Section(BenchmarkSection section) : _section(section), _start(0)
+		{
+			if (_enabled && _depth[section]++ == 0)
+			{
+				_start = now();
+			}
+		}
+		~Section()
+		{
+			if (_enabled)
+			{
+				leave(_section, _start);
+			}
+		}
+	};
+
+	/// Creates a benchmark of a saved battle.
+	BattleBenchmark(Game *game, const std::string &filename, int turns, const std::string &seed);
+	/// Loads the data and plays the battle.
+	int run();
+};
+
+}
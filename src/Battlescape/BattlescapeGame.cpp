@@ -59,6 +59,7 @@
 #include "../Savegame/BattleUnitStatistics.h"
 #include "ConfirmEndMissionState.h"
 #include "../fmath.h"
+#include "BattleBenchmark.h"
 
 namespace OpenXcom
 {
@@ -178,7 +179,8 @@ bool BattleActionCost::spendTU(std::string *message)
 BattlescapeGame::BattlescapeGame(SavedBattleGame *save, BattlescapeState *parentState) :
 	_save(save), _parentState(parentState),
 	_playerPanicHandled(true), _AIActionCounter(0), _AISecondMove(false), _playedAggroSound(false),
-	_endTurnRequested(false), _endConfirmationHandled(false), _allEnemiesNeutralized(false)
+	_endTurnRequested(false), _endConfirmationHandled(false), _allEnemiesNeutralized(false),
+	_headless(false), _battleFinished(false)
 {
 	if (_save->isPreview())
 	{
@@ -223,8 +225,8 @@ void BattlescapeGame::think()
 			_save->setUnitsFalling(false);
 			return;
 		}
-		// it's a non player side (ALIENS or CIVILIANS)
-		if (_save->getSide() != FACTION_PLAYER)
+		// it's a non player side (ALIENS or CIVILIANS), or nobody is playing
+		if (_save->getSide() != FACTION_PLAYER || _headless)
 		{
 			_save->resetUnitHitStates();
 			if (!_debugPlay)
@@ -1116,6 +1118,7 @@ bool BattlescapeGame::playableUnitSelected() const
  */
 void BattlescapeGame::handleState()
 {
+	BattleBenchmark::Section section(BENCH_BATTLE_STATES);
 	if (!_states.empty())
 	{
 		// end turn request?
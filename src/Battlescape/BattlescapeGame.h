@@ -172,6 +172,7 @@ private:
 	bool _endTurnRequested;
 	bool _endConfirmationHandled;
 	bool _allEnemiesNeutralized;
+	bool _headless, _battleFinished;
 
 	SingleRun _endTurnProcessed;
 	SingleRun _triggerProcessed;
@@ -319,6 +320,14 @@ public:
 	bool areAllEnemiesNeutralized() const { return _allEnemiesNeutralized; }
 	/// Resets the flag.
 	void resetAllEnemiesNeutralized() { _allEnemiesNeutralized = false; }
+	/// Lets the AI play every side.
+	void setHeadless(bool headless) { _headless = headless; }
+	/// Is the battle played without a player?
+	bool isHeadless() const { return _headless; }
+	/// Marks a headless battle as over.
+	void setBattleFinished() { _battleFinished = true; }
+	/// Is the headless battle over?
+	bool isBattleFinished() const { return _battleFinished; }
 };
 
 }
@@ -39,7 +39,6 @@
 #include "../Savegame/AlienBase.h"
 #include "../Savegame/EquipmentLayoutItem.h"
 #include "../Engine/Game.h"
-#include "../Engine/FileMap.h"
 #include "../Engine/Options.h"
 #include "../Engine/RNG.h"
 #include "../Engine/Exception.h"
@@ -760,7 +759,9 @@ void BattlescapeGenerator::nextStage()
 	_save->setAborted(false);
 	setMusic(ruleDeploy, true);
 	_save->setGlobalShade(_worldShade);
+	Uint32 start = SDL_GetTicks();
 	_save->getTileEngine()->calculateLighting(LL_AMBIENT, TileEngine::invalid, 0, true);
+	Log(LOG_INFO) << "Initial lighting calculated in " << SDL_GetTicks() - start << "ms.";
 }
 
 /**
@@ -944,7 +945,9 @@ void BattlescapeGenerator::run()
 	// set shade (alien bases are a little darker, sites depend on world shade)
 	_save->setGlobalShade(_worldShade);
 
+	Uint32 start = SDL_GetTicks();
 	_save->getTileEngine()->calculateLighting(LL_AMBIENT, TileEngine::invalid, 0, true);
+	Log(LOG_INFO) << "Initial lighting calculated in " << SDL_GetTicks() - start << "ms.";
 
 	if (!isPreview && _ufo && _ufo->getStatus() == Ufo::CRASHED)
 	{
@@ -975,7 +978,7 @@ void BattlescapeGenerator::deployXCOM(const RuleStartingCondition* startingCondi
 	if (!isPreview && _base != 0)
 	{
 		ItemContainer *rememberMe = _save->getBaseStorageItems();
-		for (const auto& pair : *_base->getStorageItems()->getContents())
+		for (const auto& pair : *_base->getStorageItems())
 		{
 			rememberMe->addItem(pair.first, pair.second);
 		}
@@ -1043,7 +1046,7 @@ void BattlescapeGenerator::deployXCOM(const RuleStartingCondition* startingCondi
 		for (auto* soldier : *_base->getSoldiers())
 		{
 			if ((_craft != 0 && soldier->getCraft() == _craft) ||
-				(_craft == 0 && (soldier->hasFullHealth() || soldier->canDefendBase()) && (soldier->getCraft() == 0 || soldier->getCraft()->getStatus() != "STR_OUT")))
+				(_craft == 0 && (soldier->hasFullHealth() || soldier->canDefendBase()) && (soldier->getCraft() == 0 || soldier->getCraft()->getStatusId() != CRAFT_OUT)))
 			{
 				Armor* transformedArmor = nullptr;
 				if (enviro)
@@ -1076,6 +1079,9 @@ void BattlescapeGenerator::deployXCOM(const RuleStartingCondition* startingCondi
 		}
 	}
 
+	// work out the stats of the whole base at once, the units below just pick them up
+	_base->prepareSoldierStatsWithBonuses();
+
 	// add soldiers that are in the craft or base (2x2 only)
 	{
 		for (auto* soldier : *_base->getSoldiers())
@@ -1085,7 +1091,7 @@ void BattlescapeGenerator::deployXCOM(const RuleStartingCondition* startingCondi
 				continue;
 			}
 			if ((_craft != 0 && soldier->getCraft() == _craft) ||
-				(_craft == 0 && (soldier->hasFullHealth() || soldier->canDefendBase()) && (soldier->getCraft() == 0 || soldier->getCraft()->getStatus() != "STR_OUT")))
+				(_craft == 0 && (soldier->hasFullHealth() || soldier->canDefendBase()) && (soldier->getCraft() == 0 || soldier->getCraft()->getStatusId() != CRAFT_OUT)))
 			{
 				// clear the soldier's equipment layout, we want to start fresh
 				if (_game->getSavedGame()->getDisableSoldierEquipment())
@@ -1131,7 +1137,7 @@ void BattlescapeGenerator::deployXCOM(const RuleStartingCondition* startingCondi
 				continue;
 			}
 			if ((_craft != 0 && soldier->getCraft() == _craft) ||
-				(_craft == 0 && (soldier->hasFullHealth() || soldier->canDefendBase()) && (soldier->getCraft() == 0 || soldier->getCraft()->getStatus() != "STR_OUT")))
+				(_craft == 0 && (soldier->hasFullHealth() || soldier->canDefendBase()) && (soldier->getCraft() == 0 || soldier->getCraft()->getStatusId() != CRAFT_OUT)))
 			{
 				// clear the soldier's equipment layout, we want to start fresh
 				if (_game->getSavedGame()->getDisableSoldierEquipment())
@@ -1191,9 +1197,9 @@ void BattlescapeGenerator::deployXCOM(const RuleStartingCondition* startingCondi
 	if (_craft != 0)
 	{
 		// add items that are in the craft
-		for (const auto& pair : *_craft->getItems()->getContents())
+		for (const auto& pair : *_craft->getItems())
 		{
-			if (startingCondition != 0 && !startingCondition->isItemPermitted(pair.first, _game->getMod(), _craft))
+			if (startingCondition != 0 && !startingCondition->isItemPermitted(pair.first->getType(), _game->getMod(), _craft))
 			{
 				// send disabled items back to base
 				_base->getStorageItems()->addItem(pair.first, pair.second);
@@ -1213,9 +1219,9 @@ void BattlescapeGenerator::deployXCOM(const RuleStartingCondition* startingCondi
 		if (_game->getSavedGame()->getMonthsPassed() != -1)
 		{
 			// add items that are in the base
-			for (auto i = _base->getStorageItems()->getContents()->begin(); i != _base->getStorageItems()->getContents()->end();)
+			for (const auto& pair : *_base->getStorageItems())
 			{
-				RuleItem *rule = _game->getMod()->getItem(i->first, true);
+				const RuleItem *rule = pair.first;
 				if (
 					// is item allowed in base defense?
 					rule->canBeEquippedBeforeBaseDefense() &&
@@ -1227,29 +1233,23 @@ void BattlescapeGenerator::deployXCOM(const RuleStartingCondition* startingCondi
 					// we know how to use this item
 					_game->getSavedGame()->isResearched(rule->getRequirements()))
 				{
-					for (int count = 0; count < i->second; count++)
+					for (int count = 0; count < pair.second; count++)
 					{
-						_save->createItemForTile(i->first, _craftInventoryTile);
+						_save->createItemForTile(rule, _craftInventoryTile);
 					}
-					std::map<std::string, int>::iterator tmp = i; // copy
-					++i;
 					if (!_baseInventory)
 					{
-						_base->getStorageItems()->removeItem(tmp->first, tmp->second);
+						_base->getStorageItems()->removeItem(rule, pair.second);
 					}
 				}
-				else
-				{
-					++i;
-				}
 			}
 		}
 		// add items from crafts in base
 		for (auto* craft : *_base->getCrafts())
 		{
-			if (craft->getStatus() == "STR_OUT")
+			if (craft->getStatusId() == CRAFT_OUT)
 				continue;
-			for (const auto& pair : *craft->getItems()->getContents())
+			for (const auto& pair : *craft->getItems())
 			{
 				for (int count = 0; count < pair.second; count++)
 				{
@@ -2021,18 +2021,19 @@ int BattlescapeGenerator::loadMAP(MapBlock *mapblock, int xoff, int yoff, int zo
 {
 	int sizex, sizey, sizez;
 	int x = xoff, y = yoff, z = zoff;
-	char size[3];
-	unsigned char value[4];
 	std::string filename = "MAPS/" + mapblock->getName() + ".MAP";
 	unsigned int terrainObjectID;
 
-	// Load file
-	auto mapFile = FileMap::getIStream(filename);
+	// Load file, the block keeps it for the next mission
+	const std::vector<unsigned char> &mapFile = mapblock->getMapFile();
+	if (mapFile.size() < 3)
+	{
+		throw Exception("Invalid MAP file: " + filename);
+	}
 
-	mapFile->read((char*)&size, sizeof(size));
-	sizey = (int)size[0];
-	sizex = (int)size[1];
-	sizez = (int)size[2];
+	sizey = (int)(char)mapFile[0];
+	sizex = (int)(char)mapFile[1];
+	sizez = (int)(char)mapFile[2];
 
 	mapblock->setSizeZ(sizez);
 
@@ -2082,8 +2083,9 @@ int BattlescapeGenerator::loadMAP(MapBlock *mapblock, int xoff, int yoff, int zo
 		throw Exception("Something is wrong in your map definitions, craft/ufo map is too tall?");
 	}
 
-	while (mapFile->read((char*)&value, sizeof(value)))
+	for (size_t offset = 3; offset + 4 <= mapFile.size(); offset += 4)
 	{
+		const unsigned char *value = &mapFile[offset];
 		for (int part = O_FLOOR; part < O_MAX; ++part)
 		{
 			terrainObjectID = ((unsigned char)value[part]);
@@ -2117,11 +2119,6 @@ int BattlescapeGenerator::loadMAP(MapBlock *mapblock, int xoff, int yoff, int zo
 		}
 	}
 
-	if (!mapFile->eof())
-	{
-		throw Exception("Invalid MAP file: " + filename);
-	}
-
 	// Add the craft offset to the positions of the items if we're loading a craft map
 	// But don't do so if loading a verticalLevel, since the z offset of the craft is handled by that code
 	if (craft && zoff == 0)
@@ -2217,16 +2214,16 @@ int BattlescapeGenerator::loadMAP(MapBlock *mapblock, int xoff, int yoff, int zo
  */
 void BattlescapeGenerator::loadRMP(MapBlock *mapblock, int xoff, int yoff, int zoff, int segment)
 {
-	unsigned char value[24];
 	std::string filename = "ROUTES/" + mapblock->getName() +".RMP";
-	// Load file
-	auto mapFile = FileMap::getIStream(filename);
+	// Load file, the block keeps it for the next mission
+	const std::vector<unsigned char> &mapFile = mapblock->getRouteFile();
 
 	size_t nodeOffset = _save->getNodes()->size();
 	std::vector<int> badNodes;
 	int nodesAdded = 0;
-	while (mapFile->read((char*)&value, sizeof(value)))
+	for (size_t offset = 0; offset + 24 <= mapFile.size(); offset += 24)
 	{
+		const unsigned char *value = &mapFile[offset];
 		int pos_x = value[1];
 		int pos_y = value[0];
 		int pos_z = value[2];
@@ -2293,11 +2290,6 @@ void BattlescapeGenerator::loadRMP(MapBlock *mapblock, int xoff, int yoff, int z
 			nodeCounter--;
 		}
 	}
-
-	if (!mapFile->eof())
-	{
-		throw Exception("Invalid RMP file: " + filename);
-	}
 }
 
 /**
@@ -2519,6 +2511,8 @@ void BattlescapeGenerator::loadWeapons(const std::vector<BattleItem*> &itemList)
  */
 void BattlescapeGenerator::generateMap(const std::vector<MapScript*> *script, const std::string &customUfoName, const RuleStartingCondition* startingCondition)
 {
+	Uint32 start = SDL_GetTicks();
+
 	// reset ambient sound
 	_save->setAmbientSound(Mod::NO_SOUND);
 	_save->setAmbienceRandom({});
@@ -2998,6 +2992,8 @@ void BattlescapeGenerator::generateMap(const std::vector<MapScript*> *script, co
 		throw Exception("Map failed to fully generate.");
 	}
 
+	Uint32 blocksLoaded = SDL_GetTicks();
+
 	// Put the map data set ID offset to the end of the terrains in the save since we may have loaded more than the default
 	mapDataSetIDOffset = _save->getMapDataSets()->size();
 
@@ -3078,6 +3074,8 @@ void BattlescapeGenerator::generateMap(const std::vector<MapScript*> *script, co
 
 	attachNodeLinks();
 
+	Log(LOG_INFO) << "Map generated: map script and blocks " << blocksLoaded - start << "ms, craft, ufos and nodes " << SDL_GetTicks() - blocksLoaded << "ms.";
+
 	if (_save->getMissionType() == "STR_BASE_DEFENSE" && _mod->getBaseDefenseMapFromLocation() == 1)
 	{
 		RNG::setSeed(seed);
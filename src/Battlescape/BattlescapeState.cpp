@@ -3199,6 +3199,13 @@ void BattlescapeState::popup(State *state)
  */
 void BattlescapeState::finishBattle(bool abort, int inExitArea)
 {
+	if (_battleGame->isHeadless())
+	{
+		// nobody is going to read the debriefing
+		_battleGame->setBattleFinished();
+		return;
+	}
+
 	bool isPreview = _save->isPreview();
 
 	while (!_game->isState(this))
@@ -2064,7 +2064,7 @@ void DebriefingState::prepareDebriefing()
 			// reequip crafts (only those on the base) after a base defense mission
 			for (auto* xcraft : *base->getCrafts())
 			{
-				if (xcraft->getStatus() != "STR_OUT")
+				if (xcraft->getStatusId() != CRAFT_OUT)
 					reequipCraft(base, xcraft, false);
 			}
 		}
@@ -2168,7 +2168,7 @@ void DebriefingState::prepareDebriefing()
  */
 void DebriefingState::reequipCraft(Base *base, Craft *craft, bool vehicleItemsCanBeDestroyed)
 {
-	std::map<std::string, int> craftItemsCopy = *craft->getItems()->getContents();
+	ItemContainer craftItemsCopy = *craft->getItems();
 	for (const auto& pair : craftItemsCopy)
 	{
 		int qty = base->getStorageItems()->getItem(pair.first);
@@ -2181,13 +2181,13 @@ void DebriefingState::reequipCraft(Base *base, Craft *craft, bool vehicleItemsCa
 			int missing = pair.second - qty;
 			base->getStorageItems()->removeItem(pair.first, qty);
 			craft->getItems()->removeItem(pair.first, missing);
-			ReequipStat stat = {pair.first, missing, craft->getName(_game->getLanguage()), 0};
+			ReequipStat stat = {pair.first->getType(), missing, craft->getName(_game->getLanguage()), 0};
 			_missingItems.push_back(stat);
 		}
 	}
 
 	// Now let's see the vehicles
-	ItemContainer craftVehicles;
+	ItemContainer craftVehicles(_game->getMod());
 	for (auto* vehicle : *craft->getVehicles())
 	{
 		craftVehicles.addItem(vehicle->getRules());
@@ -2205,16 +2205,16 @@ void DebriefingState::reequipCraft(Base *base, Craft *craft, bool vehicleItemsCa
 	craft->getVehicles()->clear();
 
 	// Ok, now read those vehicles
-	for (const auto& pair : *craftVehicles.getContents())
+	for (const auto& pair : craftVehicles)
 	{
 		int qty = base->getStorageItems()->getItem(pair.first);
-		RuleItem *tankRule = _game->getMod()->getItem(pair.first, true);
+		RuleItem *tankRule = pair.first;
 		int size = tankRule->getVehicleUnit()->getArmor()->getTotalSize();
 		int canBeAdded = std::min(qty, pair.second);
 		if (qty < pair.second)
 		{ // missing tanks
 			int missing = pair.second - qty;
-			ReequipStat stat = {pair.first, missing, craft->getName(_game->getLanguage()), 0};
+			ReequipStat stat = {tankRule->getType(), missing, craft->getName(_game->getLanguage()), 0};
 			_missingItems.push_back(stat);
 		}
 		if (tankRule->getVehicleClipAmmo() == nullptr)
@@ -40,6 +40,7 @@ class Timer;
 class Text;
 class Tile;
 class UnitSprite;
+class UnitSpriteCache;
 
 enum CursorType { CT_NONE, CT_NORMAL, CT_AIM, CT_PSI, CT_WAYPOINT, CT_THROW };
 enum TilePart : int;
@@ -95,6 +96,7 @@ private:
 	bool _explosionInFOV, _launch;
 	BattlescapeMessage *_message;
 	Camera *_camera;
+	UnitSpriteCache *_unitSpriteCache;
 	int _visibleMapHeight;
 	std::vector<Position> _waypoints;
 	bool _unitDying, _smoothCamera, _smoothingEngaged, _flashScreen;
@@ -27,6 +27,7 @@
 #include "../Engine/Options.h"
 #include "../fmath.h"
 #include "BattlescapeGame.h"
+#include "BattleBenchmark.h"
 
 namespace OpenXcom
 {
@@ -82,6 +83,7 @@ PathfindingNode *Pathfinding::getNode(Position pos)
  */
 void Pathfinding::calculate(BattleUnit *unit, Position endPosition, BattleActionMove bam, const BattleUnit *missileTarget, int maxTUCost)
 {
+	BattleBenchmark::Section section(BENCH_PATHFINDING);
 	_totalTUCost = {};
 	_path.clear();
 
@@ -284,6 +286,10 @@ PathfindingStep Pathfinding::getTUCost(Position startPosition, int direction, co
 	const Tile* destinationTile[4] = { };
 	const Tile* aboveDestination[4] = { };
 	const Tile* belowDestination[4] = { };
+	int startIndex[4] = { };
+	int destinationIndex[4] = { };
+	const TileHotData& hot = _save->getTileHotData();
+	const int layerSize = _save->getMapSizeX() * _save->getMapSizeY();
 
 	// init variables
 	for (int i = 0; i < numberOfParts; ++i)
@@ -294,6 +300,8 @@ PathfindingStep Pathfinding::getTUCost(Position startPosition, int direction, co
 		{
 			return {{INVALID_MOVE_COST, 0}};
 		}
+		startIndex[i] = _save->getTileIndex(startPosition + offsets[i]);
+		destinationIndex[i] = _save->getTileIndex(pos + offsets[i]);
 		startTile[i] = st;
 		aboveStart[i] = _save->getAboveTile(st);
 		belowStart[i] = _save->getBelowTile(st);
@@ -308,21 +316,22 @@ PathfindingStep Pathfinding::getTUCost(Position startPosition, int direction, co
 		const int maskCurrentPart = 1 << i;
 		const bool checkClimbing = (i == 0) && (numberOfParts == 1) &&  movementType != MT_FLY;
 
-		if (direction < DIR_UP && startTile[i]->getTerrainLevel() > - 16)
+		const int startLevel = hot.terrainLevel[startIndex[i]];
+		if (direction < DIR_UP && startLevel > - 16)
 		{
 			// check if we can go this way
 			if (isBlockedDirection(unit, startTile[i], direction, bam, missileTarget))
 				return {{INVALID_MOVE_COST, 0}};
-			if (startTile[i]->getTerrainLevel() - destinationTile[i]->getTerrainLevel() > 8)
+			if (startLevel - hot.terrainLevel[destinationIndex[i]] > 8)
 				return {{INVALID_MOVE_COST, 0}};
 		}
 
 		// if we are on a stairs try to go up a level
-		if (direction < DIR_UP && startTile[i]->getTerrainLevel() <= -16 && aboveDestination[i] && !aboveDestination[i]->hasNoFloor(_save))
+		if (direction < DIR_UP && startLevel <= -16 && aboveDestination[i] && !aboveDestination[i]->hasNoFloor(_save))
 		{
 			maskOfPartsGoingUp |= maskCurrentPart;
 		}
-		else if (direction < DIR_UP && movementType != MT_FLY && belowDestination[i] && canFallDown(destinationTile[i]) && belowDestination[i]->getTerrainLevel() <= -12)
+		else if (direction < DIR_UP && movementType != MT_FLY && belowDestination[i] && canFallDown(destinationTile[i]) && hot.terrainLevel[destinationIndex[i] - layerSize] <= -12)
 		{
 			maskOfPartsGoingDown |= maskCurrentPart;
 		}
@@ -376,10 +385,12 @@ PathfindingStep Pathfinding::getTUCost(Position startPosition, int direction, co
 		if (triedStairs)
 		{
 			destinationTile[i] = aboveDestination[i];
+			destinationIndex[i] += layerSize;
 		}
 		else if (direction != DIR_DOWN && triedStairsDown)
 		{
 			destinationTile[i] = belowDestination[i];
+			destinationIndex[i] -= layerSize;
 		}
 
 		// check if the destination tile can be walked over
@@ -407,7 +418,7 @@ PathfindingStep Pathfinding::getTUCost(Position startPosition, int direction, co
 	{
 		for (int i = 0; i < numberOfParts; ++i)
 		{
-			if (destinationTile[i]->getFire() > 0)
+			if (hot.fire[destinationIndex[i]] > 0)
 			{
 				firePenaltyCost = FIRE_PREVIEW_MOVE_COST; // try to find a better path, but don't exclude this path entirely.
 			}
@@ -428,7 +439,7 @@ PathfindingStep Pathfinding::getTUCost(Position startPosition, int direction, co
 			// check if we can go this way
 			if (isBlockedDirection(unit, startTile[i], direction, bam, missileTarget))
 				return {{INVALID_MOVE_COST, 0}};
-			if (startTile[i]->getTerrainLevel() - destinationTile[i]->getTerrainLevel() > 8)
+			if (hot.terrainLevel[startIndex[i]] - hot.terrainLevel[destinationIndex[i]] > 8)
 				return {{INVALID_MOVE_COST, 0}};
 		}
 		else if (direction >= DIR_UP && !triedStairsDown)
@@ -446,13 +457,14 @@ PathfindingStep Pathfinding::getTUCost(Position startPosition, int direction, co
 		if (upperLevel)
 		{
 			startTile[i] = _save->getAboveTile(startTile[i]);
+			startIndex[i] += layerSize;
 
 			if (direction < DIR_UP)
 			{
 				// check if we can go this way
 				if (isBlockedDirection(unit, startTile[i], direction, bam, missileTarget))
 					return {{INVALID_MOVE_COST, 0}};
-				if (startTile[i]->getTerrainLevel() - destinationTile[i]->getTerrainLevel() > 8)
+				if (hot.terrainLevel[startIndex[i]] - hot.terrainLevel[destinationIndex[i]] > 8)
 					return {{INVALID_MOVE_COST, 0}};
 			}
 		}
@@ -476,7 +488,7 @@ PathfindingStep Pathfinding::getTUCost(Position startPosition, int direction, co
 		}
 
 		// if we don't want to fall down and there is no floor, we can't know the TUs so it's default to 4
-		if (direction < DIR_UP && !triedStairsDown && destinationTile[i]->hasNoFloor(0))
+		if (direction < DIR_UP && !triedStairsDown && hot.hasFlag(destinationIndex[i], THF_NO_FLOOR))
 		{
 			cost = DEFAULT_MOVE_COST;
 		}
@@ -1364,6 +1376,7 @@ bool Pathfinding::bresenhamPath(Position origin, Position target, BattleActionMo
  */
 std::vector<int> Pathfinding::findReachable(const BattleUnit *unit, const BattleActionCost &cost)
 {
+	BattleBenchmark::Section section(BENCH_PATHFINDING);
 	const Position start = unit->getPosition();
 	int tuMax = unit->getTimeUnits() - cost.Time;
 	int energyMax = unit->getEnergy() - cost.Energy;
@@ -43,6 +43,8 @@
 #include "ProjectileFlyBState.h"
 #include "MeleeAttackBState.h"
 #include "../fmath.h"
+#include "BattleBenchmark.h"
+#include "../Engine/Parallel.h"
 
 namespace OpenXcom
 {
@@ -259,6 +261,28 @@ MapSubset mapAreaExpand(MapSubset gs, int radius)
 	return { std::make_pair(gs.beg_x - radius, gs.end_x + radius), std::make_pair(gs.beg_y - radius, gs.end_y + radius) };
 }
 
+/**
+ * Minimum number of map rows given to one thread when lighting the whole map.
+ */
+const int LightingRowsPerThread = 8;
+
+/**
+ * Splits subset of map into bands of rows, one for each thread.
+ * @param gs Square subset of map area.
+ * @return Bands covering the subset, in order.
+ */
+std::vector<MapSubset> mapAreaRows(MapSubset gs)
+{
+	const int rows = gs.size_y();
+	const int count = std::max(1, std::min(Parallel::getThreadCount(), rows / LightingRowsPerThread));
+	std::vector<MapSubset> bands;
+	for (int i = 0; i < count; ++i)
+	{
+		bands.push_back({ std::make_pair(gs.beg_x, gs.end_x), std::make_pair(gs.beg_y + rows * i / count, gs.beg_y + rows * (i + 1) / count) });
+	}
+	return bands;
+}
+
 
 
 constexpr static Uint32 MaskBlockDirMul = 9;
@@ -1112,6 +1136,7 @@ void TileEngine::calculateUnitLighting(MapSubset gs)
 
 void TileEngine::calculateLighting(LightLayers layer, Position position, int eventRadius, bool terrianChanged)
 {
+	BattleBenchmark::Section section(BENCH_LIGHTING);
 	const auto gsMap = MapSubset{ _save->getMapSizeX(), _save->getMapSizeY() };
 	auto gsDynamic = gsMap;
 	auto gsStatic = gsDynamic;
@@ -1122,57 +1147,38 @@ void TileEngine::calculateLighting(LightLayers layer, Position position, int eve
 		gsStatic = mapArea(position, eventRadius + getMaxStaticLightDistance());
 	}
 
+	// whole map updates are split into bands of rows, every tile is only written by
+	// the band it is in and gets light from sources in the same order as before
+	const auto bands = position != invalid ? std::vector<MapSubset>{ gsStatic } : mapAreaRows(gsMap);
+
 	if (terrianChanged)
 	{
-		iterateTiles(
-			_save,
-			position != invalid ? mapArea(position, eventRadius + 1) : gsMap,
-			[&](Tile* tile)
-			{
-				const auto currPos = tile->getPosition();
-				const auto index = _save->getTileIndex(currPos);
-				const auto* mapData = tile->getMapData(O_OBJECT);
-				auto& cache = _blockVisibility[index];
-
-				cache = {};
-				cache.height = -tile->getTerrainLevel();
-				if (mapData)
+		const auto& hot = _save->getTileHotData();
+		Parallel::forEach((int)bands.size(), [&](int band)
+		{
+			iterateTiles(
+				_save,
+				position != invalid ? mapArea(position, eventRadius + 1) : bands[band],
+				[&](Tile* tile)
 				{
-					if (mapData->getTUCost(MT_WALK) == Pathfinding::INVALID_MOVE_COST)
+					const auto currPos = tile->getPosition();
+					const auto index = _save->getTileIndex(currPos);
+					const auto* mapData = tile->getMapData(O_OBJECT);
+					auto& cache = _blockVisibility[index];
+
+					cache = {};
+					cache.height = -hot.terrainLevel[index];
+					if (mapData)
 					{
-						cache.height = 24;
+						if (mapData->getTUCost(MT_WALK) == Pathfinding::INVALID_MOVE_COST)
+						{
+							cache.height = 24;
+						}
 					}
-				}
-				addSmoke(cache, tile->getSmoke() > 0);
-				addFire(cache, tile->getFire() > 0);
-				addBlockUp(cache, verticalBlockage(tile, _save->getAboveTile(tile), DT_NONE) > 127);
-				addBlockDown(cache, verticalBlockage(tile, _save->getBelowTile(tile), DT_NONE) > 127);
-				for (int dir = 0; dir < 8; ++dir)
-				{
-					Position pos = {};
-					Pathfinding::directionToVector(dir, &pos);
-					auto* tileNext = _save->getTile(currPos + pos);
-					auto result = 0;
-
-					result = horizontalBlockage(tile, tileNext, DT_NONE, true);
-					addBigWallDir(cache, dir, (result == -1));
-
-					result = horizontalBlockage(tile, tileNext, DT_NONE);
-					addBlockDir(cache, dir, 0, (result > 127 || result == -1));
-
-					tileNext = _save->getTile(currPos + pos + Position{ 0, 0, 1 });
-					addBlockDir(cache, dir, 1, verticalBlockage(tile, tileNext, DT_NONE) > 127);
-
-					tileNext = _save->getTile(currPos + pos + Position{ 0, 0, -1 });
-					addBlockDir(cache, dir, -1, verticalBlockage(tile, tileNext, DT_NONE) > 127);
-				}
-
-				_lightPropagationTerrainBlocking[index] = getBlockDir(cache);
-				//HACK: some times light can lit wall objects even if its can't propagate through them,
-				// for simplicity we consider them transparent.
-				// But if is already big wall then next step to big wall is blocked.
-				if (tile->getMapData(O_OBJECT) == nullptr || tile->getMapData(O_OBJECT)->getBigWall())
-				{
+					addSmoke(cache, hot.smoke[index] > 0);
+					addFire(cache, hot.fire[index] > 0);
+					addBlockUp(cache, verticalBlockage(tile, _save->getAboveTile(tile), DT_NONE) > 127);
+					addBlockDown(cache, verticalBlockage(tile, _save->getBelowTile(tile), DT_NONE) > 127);
 					for (int dir = 0; dir < 8; ++dir)
 					{
 						Position pos = {};
@@ -1181,14 +1187,41 @@ void TileEngine::calculateLighting(LightLayers layer, Position position, int eve
 						auto result = 0;
 
 						result = horizontalBlockage(tile, tileNext, DT_NONE, true);
-						if (result == -1)
+						addBigWallDir(cache, dir, (result == -1));
+
+						result = horizontalBlockage(tile, tileNext, DT_NONE);
+						addBlockDir(cache, dir, 0, (result > 127 || result == -1));
+
+						tileNext = _save->getTile(currPos + pos + Position{ 0, 0, 1 });
+						addBlockDir(cache, dir, 1, verticalBlockage(tile, tileNext, DT_NONE) > 127);
+
+						tileNext = _save->getTile(currPos + pos + Position{ 0, 0, -1 });
+						addBlockDir(cache, dir, -1, verticalBlockage(tile, tileNext, DT_NONE) > 127);
+					}
+
+					_lightPropagationTerrainBlocking[index] = getBlockDir(cache);
+					//HACK: some times light can lit wall objects even if its can't propagate through them,
+					// for simplicity we consider them transparent.
+					// But if is already big wall then next step to big wall is blocked.
+					if (tile->getMapData(O_OBJECT) == nullptr || tile->getMapData(O_OBJECT)->getBigWall())
+					{
+						for (int dir = 0; dir < 8; ++dir)
 						{
-							_lightPropagationTerrainBlocking[index] &= ~selectBit(dir, 0);
+							Position pos = {};
+							Pathfinding::directionToVector(dir, &pos);
+							auto* tileNext = _save->getTile(currPos + pos);
+							auto result = 0;
+
+							result = horizontalBlockage(tile, tileNext, DT_NONE, true);
+							if (result == -1)
+							{
+								_lightPropagationTerrainBlocking[index] &= ~selectBit(dir, 0);
+							}
 						}
 					}
 				}
-			}
-		);
+			);
+		});
 	}
 
 	iterateTilesLightMaxBound(_save, position, eventRadius, getMaxDynamicLightDistance(), gsMap, _lightPropagationTempNeedUpdate, _lightPropagationTerrainBlocking);
@@ -1214,8 +1247,14 @@ void TileEngine::calculateLighting(LightLayers layer, Position position, int eve
 		}
 	);
 
-	if (layer <= LL_AMBIENT) calculateSunShading(gsStatic);
-	if (layer <= LL_FIRE) calculateTerrainBackground(gsStatic);
+	if (layer <= LL_FIRE)
+	{
+		Parallel::forEach((int)bands.size(), [&](int band)
+		{
+			if (layer <= LL_AMBIENT) calculateSunShading(bands[band]);
+			calculateTerrainBackground(bands[band]);
+		});
+	}
 	if (layer <= LL_ITEMS) calculateTerrainItems(gsDynamic);
 	if (layer <= LL_UNITS) calculateUnitLighting(gsDynamic);
 }
@@ -1237,7 +1276,8 @@ void TileEngine::addLight(MapSubset gs, Position center, int power, LightLayers
 	const auto items = layer == LL_ITEMS;
 	const auto units = layer == LL_UNITS;
 	const auto ground = items || fire;
-	const auto tileHeight = _save->getTile(center)->getTerrainLevel();
+	const auto& hot = _save->getTileHotData();
+	const auto tileHeight = hot.terrainLevel[_save->getTileIndex(center)];
 	const auto divide = (fire ? 8 : 4);
 	const auto accuracy = TileEngine::voxelTileSize / divide;
 	const auto offsetCenter = (accuracy / 2 + Position(-1, -1, (ground ? 0 : accuracy.z/4) - tileHeight * accuracy.z / 24));
@@ -1256,7 +1296,7 @@ void TileEngine::addLight(MapSubset gs, Position center, int power, LightLayers
 			const auto target = tile->getPosition();
 			const auto diff = target - center;
 			const auto distance = (int)Round(Position::distance(target.toVoxel(), center.toVoxel()) / Position::TileXY);
-			const auto targetLight = tile->getLightMulti(layer);
+			const auto targetLight = hot.getLightMulti(idx, layer);
 			auto currLight = power - distance;
 
 			if (currLight <= targetLight)
@@ -1274,7 +1314,7 @@ void TileEngine::addLight(MapSubset gs, Position center, int power, LightLayers
 			}
 
 			Position startVoxel = (center * accuracy) + offsetCenter;
-			Position endVoxel = (target * accuracy) + offsetTarget + Position(0, 0, std::max(0, (_blockVisibility[_save->getTileIndex(target)].height - 1) / (2 * divide)));
+			Position endVoxel = (target * accuracy) + offsetTarget + Position(0, 0, std::max(0, (_blockVisibility[idx].height - 1) / (2 * divide)));
 			Position offsetA{ 1, 0, 0 };
 			Position offsetB{ -1, 1, 0 };
 			if ((diff.x > 0) ^ (diff.y > 0))
@@ -1657,6 +1697,7 @@ void TileEngine::calculateTilesInFOV(BattleUnit *unit, const Position eventPos,
 */
 bool TileEngine::calculateFOV(BattleUnit *unit, bool doTileRecalc, bool doUnitRecalc)
 {
+	BattleBenchmark::Section section(BENCH_FOV);
 	//Force a full FOV recheck for this unit.
 	if (doTileRecalc) calculateTilesInFOV(unit);
 	return doUnitRecalc ? calculateUnitsInFOV(unit) : false;
@@ -1784,7 +1825,8 @@ bool TileEngine::visible(BattleUnit *currentUnit, Tile *tile)
 		int densityOfFire = 0;
 		Position voxelToTile(16, 16, 24);
 		Position trackTile(-1, -1, -1);
-		Tile *t = 0;
+		const auto& hot = _save->getTileHotData();
+		int t = 0;
 
 		for (int i = 0; i < visibleDistanceVoxels; i++)
 		{
@@ -1792,15 +1834,15 @@ bool TileEngine::visible(BattleUnit *currentUnit, Tile *tile)
 			if (trackTile != _trajectory.at(i))
 			{
 				trackTile = _trajectory.at(i);
-				t = _save->getTile(trackTile);
+				t = _save->getTileIndex(trackTile);
 			}
-			if (t->getFire() == 0)
+			if (hot.fire[t] == 0)
 			{
-				densityOfSmoke += t->getSmoke();
+				densityOfSmoke += hot.smoke[t];
 			}
 			else
 			{
-				densityOfFire += t->getFire();
+				densityOfFire += hot.fire[t];
 			}
 		}
 		visibleDistanceMaxVoxel = getMaxVoxelViewDistance(); // reset again (because of smoke formula)
@@ -1997,7 +2039,8 @@ bool TileEngine::isTileInLOS(BattleAction *action, Tile *tile)
 		int densityOfFire = 0;
 		Position voxelToTile(16, 16, 24);
 		Position trackTile(-1, -1, -1);
-		Tile *t = 0;
+		const auto& hot = _save->getTileHotData();
+		int t = 0;
 
 		for (int i = 0; i < visibleDistanceVoxels; i++)
 		{
@@ -2005,15 +2048,15 @@ bool TileEngine::isTileInLOS(BattleAction *action, Tile *tile)
 			if (trackTile != _trajectory.at(i))
 			{
 				trackTile = _trajectory.at(i);
-				t = _save->getTile(trackTile);
+				t = _save->getTileIndex(trackTile);
 			}
-			if (t->getFire() == 0)
+			if (hot.fire[t] == 0)
 			{
-				densityOfSmoke += t->getSmoke();
+				densityOfSmoke += hot.smoke[t];
 			}
 			else
 			{
-				densityOfFire += t->getFire();
+				densityOfFire += hot.fire[t];
 			}
 		}
 		visibleDistanceMaxVoxel = getMaxVoxelViewDistance(); // reset again (because of smoke formula)
@@ -2387,6 +2430,7 @@ bool TileEngine::canTargetTile(Position *originVoxel, Tile *tile, int part, Posi
  */
 void TileEngine::calculateFOV(Position position, int eventRadius, const bool updateTiles, const bool appendToTileVisibility)
 {
+	BattleBenchmark::Section section(BENCH_FOV);
 	int updateRadius;
 	if (eventRadius == -1)
 	{
@@ -2425,6 +2469,7 @@ void TileEngine::calculateFOV(Position position, int eventRadius, const bool upd
  */
 bool TileEngine::checkReactionFire(BattleUnit *unit, const BattleAction &originalAction)
 {
+	BattleBenchmark::Section section(BENCH_REACTION_FIRE);
 	if (_save->isPreview())
 	{
 		return false;
@@ -5603,6 +5648,7 @@ bool TileEngine::validateThrow(BattleAction &action, Position originVoxel, Posit
  */
 void TileEngine::recalculateFOV()
 {
+	BattleBenchmark::Section section(BENCH_FOV);
 	for (auto* bu : *_save->getUnits())
 	{
 		if (bu->getTile() != 0)
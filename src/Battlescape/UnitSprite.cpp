@@ -17,6 +17,8 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "UnitSprite.h"
+#include <algorithm>
+#include <tuple>
 #include "../Engine/SurfaceSet.h"
 #include "../Mod/RuleItem.h"
 #include "../Mod/Armor.h"
@@ -38,14 +40,14 @@ namespace OpenXcom
  * @param x X position in pixels.
  * @param y Y position in pixels.
  */
-UnitSprite::UnitSprite(Surface* dest, const Mod* mod, const SavedBattleGame* save, int frame, bool helmet) :
+UnitSprite::UnitSprite(Surface* dest, const Mod* mod, const SavedBattleGame* save, int frame, bool helmet, UnitSpriteCache *cache) :
 	_unit(0), _itemR(0), _itemL(0),
 	_unitSurface(0),
 	_itemSurface(const_cast<Mod*>(mod)->getSurfaceSet("HANDOB.PCK")),
 	_fireSurface(const_cast<Mod*>(mod)->getSurfaceSet("SMOKE.PCK")),
 	_breathSurface(const_cast<Mod*>(mod)->getSurfaceSet("BREATH-1.PCK", false)),
 	_facingArrowSurface(const_cast<Mod*>(mod)->getSurfaceSet("DETBLOB.DAT")),
-	_dest(dest), _save(save), _mod(mod),
+	_dest(dest), _save(save), _mod(mod), _cache(cache),
 	_part(0), _animationFrame(frame), _drawingRoutine(0),
 	_helmet(helmet),
 	_x(0), _y(0), _shade(0), _burn(0),
@@ -70,6 +72,11 @@ namespace
  */
 const int InvalidSpriteIndex = -256;
 
+/**
+ * Space around a cached frame for parts drawn with an offset.
+ */
+const int CacheMargin = 16;
+
 /**
  * Get item if can be visible on sprite.
  */
@@ -82,8 +89,132 @@ const BattleItem *getIfVisible(const BattleItem *item)
 	return 0;
 }
 
+/**
+ * Check if any script given by a mod can change how a sprite is selected or blitted.
+ * Default scripts only read the recolor table, burn and shade, which the cache handles.
+ */
+bool hasScript(const ScriptContainerEventsBase& c)
+{
+	auto events = c.dataEvents();
+	return (c.data() && !c.isDefault()) || (events && (static_cast<bool>(events[0]) || static_cast<bool>(events[1])));
+}
+
+/**
+ * Check if the drawing routine animates the unit on its own.
+ */
+bool usesAnimationFrame(int drawingRoutine)
+{
+	switch (drawingRoutine)
+	{
+	case 2:
+	case 3:
+	case 8:
+	case 9:
+	case 11:
+	case 12:
+	case 16:
+	case 21:
+	case 22:
+		return true;
+	default:
+		return false;
+	}
+}
+
 } //namespace
 
+/**
+ * Compares all fields of two cache keys.
+ * @param other Key to compare with.
+ * @return True if both keys compose the same frame.
+ */
+bool UnitSpriteCache::Key::operator==(const Key &other) const
+{
+	auto tie = [](const Key &k)
+	{
+		return std::tie(k.armor, k.itemR, k.itemL, k.itemRInRightHand, k.activeHandRight, k.kneeled, k.floating, k.floorAbove, k.helmet,
+			k.status, k.direction, k.turretDirection, k.turretType, k.walkingPhase, k.fallingPhase,
+			k.gender, k.movementType, k.originalMovementType, k.standHeight, k.animationFrame,
+			k.burn, k.recolorSize, k.recolor);
+	};
+	return tie(*this) == tie(other);
+}
+
+/**
+ * Creates an empty cache.
+ */
+UnitSpriteCache::UnitSpriteCache()
+{
+
+}
+
+/**
+ * Deletes the cached frames.
+ */
+UnitSpriteCache::~UnitSpriteCache()
+{
+	clear();
+}
+
+/**
+ * Gets the frame composed for a unit part, if the unit still looks the same.
+ * Units are only used as identity, so entries of removed units are harmless.
+ * @param unit Unit the frame belongs to.
+ * @param part Part of a large unit.
+ * @param key Current state of the unit.
+ * @return Composed frame, or null if it has to be composed again.
+ */
+Surface *UnitSpriteCache::get(const BattleUnit *unit, int part, const Key &key) const
+{
+	auto it = _entries.find(std::make_pair(unit, part));
+	if (it != _entries.end() && it->second.key == key)
+	{
+		return it->second.frame;
+	}
+	return 0;
+}
+
+/**
+ * Gets a blank frame for a unit part, replacing the previous one.
+ * @param unit Unit the frame belongs to.
+ * @param part Part of a large unit.
+ * @param key State of the unit the frame is composed for.
+ * @param width Width of the frame in pixels.
+ * @param height Height of the frame in pixels.
+ * @return Frame to compose the unit part on.
+ */
+Surface *UnitSpriteCache::store(const BattleUnit *unit, int part, const Key &key, int width, int height)
+{
+	Entry &entry = _entries[std::make_pair(unit, part)];
+	if (entry.frame && (entry.frame->getWidth() != width || entry.frame->getHeight() != height))
+	{
+		delete entry.frame;
+		entry.frame = 0;
+	}
+	if (entry.frame)
+	{
+		entry.frame->clear();
+	}
+	else
+	{
+		entry.frame = new Surface(width, height);
+	}
+	entry.key = key;
+	return entry.frame;
+}
+
+/**
+ * Deletes all cached frames.
+ */
+void UnitSpriteCache::clear()
+{
+	for (auto& pair : _entries)
+	{
+		delete pair.second.frame;
+	}
+	_entries.clear();
+}
+
 /**
  * Get item sprite for item.
  * @param item item what we want draw.
@@ -217,6 +348,63 @@ void UnitSprite::draw(const BattleUnit* unit, int part, int x, int y, int shade,
 		}
 	}
 
+	if (_cache && isCacheable())
+	{
+		UnitSpriteCache::Key key = getCacheKey();
+		Surface *frame = _cache->get(_unit, _part, key);
+		if (!frame)
+		{
+			// compose the unit unshaded at the center of its frame
+			int width = std::max(_unitSurface->getWidth(), _itemSurface->getWidth()) + 2 * CacheMargin;
+			int height = std::max(_unitSurface->getHeight(), _itemSurface->getHeight()) + 2 * CacheMargin;
+			frame = _cache->store(_unit, _part, key, width, height);
+
+			Surface *dest = _dest;
+			_dest = frame;
+			_x = CacheMargin;
+			_y = CacheMargin;
+			_shade = 0;
+			_mask = GraphSubset(width, height);
+			drawBody();
+			_dest = dest;
+			_x = x;
+			_y = y;
+			_shade = shade;
+			_mask = mask;
+		}
+		frame->blitNShade(_dest, _x - CacheMargin, _y - CacheMargin, _shade, _mask);
+	}
+	else
+	{
+		drawBody();
+	}
+	// draw fire
+	if (unit->getFire() > 0)
+	{
+		_fireSurface->getFrame(4 + (_animationFrame / 2) % 4)->blitNShade(_dest, _x, _y, 0, _mask);
+	}
+	if (_breathSurface && _helmet && unit->getBreathExhaleFrame() >= 0 && armor->drawBubbles() && !unit->getFloorAbove())
+	{
+		auto* tmpSurface = _breathSurface->getFrame(unit->getBreathExhaleFrame());
+		if (tmpSurface)
+		{
+			// lower the bubbles for shorter or kneeling units.
+			tmpSurface->blitNShade(_dest, _x, _y- 30 + (22 - unit->getHeight()), shade, _mask);
+		}
+	}
+	if (isAltPressed)
+	{
+		// draw unit facing indicator
+		auto* tmpSurface = _facingArrowSurface->getFrame(7 + ((unit->getDirection() + 1) % 8));
+		tmpSurface->blitNShade(_dest, _x, _y, 0);
+	}
+}
+
+/**
+ * Calls the drawing routine matching the armor of the unit.
+ */
+void UnitSprite::drawBody()
+{
 	// Array of drawing routines
 	void (UnitSprite::*routines[])() =
 	{
@@ -244,28 +432,73 @@ void UnitSprite::draw(const BattleUnit* unit, int part, int x, int y, int shade,
 		&UnitSprite::drawRoutine21,
 		&UnitSprite::drawRoutine3,
 	};
-	// Call the matching routine
 	(this->*(routines[_drawingRoutine]))();
-	// draw fire
-	if (unit->getFire() > 0)
+}
+
+/**
+ * Checks if the unit looks the same every time it is drawn in the same state,
+ * which is not true when scripts select or recolor its sprites.
+ * @return True if the composed frame can be reused.
+ */
+bool UnitSprite::isCacheable() const
+{
+	if (_unit->getRecolor().size() > 4)
 	{
-		_fireSurface->getFrame(4 + (_animationFrame / 2) % 4)->blitNShade(_dest, _x, _y, 0, _mask);
+		// more than the cache key can hold
+		return false;
 	}
-	if (_breathSurface && _helmet && unit->getBreathExhaleFrame() >= 0 && armor->drawBubbles() && !unit->getFloorAbove())
+	const auto* armor = _unit->getArmor();
+	if (hasScript(armor->getScript<ModScript::SelectUnitSprite>()) || hasScript(armor->getScript<ModScript::RecolorUnitSprite>()))
 	{
-		auto* tmpSurface = _breathSurface->getFrame(unit->getBreathExhaleFrame());
-		if (tmpSurface)
-		{
-			// lower the bubbles for shorter or kneeling units.
-			tmpSurface->blitNShade(_dest, _x, _y- 30 + (22 - unit->getHeight()), shade, _mask);
-		}
+		return false;
 	}
-	if (isAltPressed)
+	for (const auto* item : { _itemR, _itemL })
 	{
-		// draw unit facing indicator
-		auto* tmpSurface = _facingArrowSurface->getFrame(7 + ((unit->getDirection() + 1) % 8));
-		tmpSurface->blitNShade(_dest, _x, _y, 0);
+		if (item && (hasScript(item->getRules()->getScript<ModScript::SelectItemSprite>()) || hasScript(item->getRules()->getScript<ModScript::RecolorItemSprite>())))
+		{
+			return false;
+		}
 	}
+	return true;
+}
+
+/**
+ * Collects everything the drawing routines read from the unit.
+ * @return Key of the composed frame.
+ */
+UnitSpriteCache::Key UnitSprite::getCacheKey() const
+{
+	UnitSpriteCache::Key key;
+	key.armor = _unit->getArmor();
+	key.itemR = _itemR ? _itemR->getRules() : 0;
+	key.itemL = _itemL ? _itemL->getRules() : 0;
+	key.itemRInRightHand = _itemR && _itemR->getSlot() && _itemR->getSlot()->isRightHand();
+	// sortRifles() draws only the active one of two two-handed weapons
+	key.activeHandRight = _unit->getActiveHand(_itemL, _itemR) == _itemR;
+	key.kneeled = _unit->isKneeled();
+	key.floating = _unit->isFloating();
+	key.floorAbove = _unit->getFloorAbove();
+	key.helmet = _helmet;
+	key.status = _unit->getStatus();
+	key.direction = _unit->getDirection();
+	key.turretDirection = _unit->getTurretDirection();
+	key.turretType = _unit->getTurretType();
+	key.walkingPhase = _unit->getWalkingPhase();
+	key.fallingPhase = _unit->getFallingPhase();
+	key.gender = _unit->getGender();
+	key.movementType = _unit->getMovementType();
+	key.originalMovementType = _unit->getOriginalMovementType();
+	key.standHeight = _unit->getStandHeight();
+	key.animationFrame = usesAnimationFrame(_drawingRoutine) ? _animationFrame : 0;
+	key.burn = _burn;
+	// read by the default recolor script, covers face, hair, utile and rank colors
+	key.recolor = 0;
+	key.recolorSize = (int)_unit->getRecolor().size();
+	for (const auto& pair : _unit->getRecolor())
+	{
+		key.recolor = (key.recolor << 16) | (pair.first << 8) | pair.second;
+	}
+	return key;
 }
 
 /**
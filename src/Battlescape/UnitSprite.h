@@ -19,6 +19,8 @@
  */
 #include "../Engine/Surface.h"
 #include "../Engine/Script.h"
+#include <map>
+#include <utility>
 
 namespace OpenXcom
 {
@@ -28,6 +30,50 @@ class BattleItem;
 class SavedBattleGame;
 class SurfaceSet;
 class Mod;
+class Armor;
+class RuleItem;
+
+/**
+ * Keeps the last composed frame of every unit part drawn on the map,
+ * so units that look the same as in the previous frame take one blit.
+ * Frames are composed without shade, which is applied when they are drawn.
+ */
+class UnitSpriteCache
+{
+public:
+	/// Everything about a unit that can change how its frame is composed.
+	struct Key
+	{
+		const Armor *armor;
+		const RuleItem *itemR, *itemL;
+		bool itemRInRightHand, activeHandRight, kneeled, floating, floorAbove, helmet;
+		int status, direction, turretDirection, turretType, walkingPhase, fallingPhase;
+		int gender, movementType, originalMovementType, standHeight, animationFrame;
+		int burn, recolorSize;
+		Uint64 recolor;
+
+		/// Compares two keys.
+		bool operator==(const Key &other) const;
+	};
+private:
+	struct Entry
+	{
+		Key key;
+		Surface *frame;
+	};
+	std::map<std::pair<const BattleUnit*, int>, Entry> _entries;
+public:
+	/// Creates an empty cache.
+	UnitSpriteCache();
+	/// Cleans up the cached frames.
+	~UnitSpriteCache();
+	/// Gets the frame of a unit part, if it is still valid.
+	Surface *get(const BattleUnit *unit, int part, const Key &key) const;
+	/// Gets a blank frame to compose a unit part on.
+	Surface *store(const BattleUnit *unit, int part, const Key &key, int width, int height);
+	/// Forgets all frames.
+	void clear();
+};
 
 /**
  * A class that renders a specific unit, given its render rules
@@ -55,6 +101,7 @@ private:
 	Surface *_dest;
 	const SavedBattleGame *_save;
 	const Mod *_mod;
+	UnitSpriteCache *_cache;
 	int _part, _animationFrame, _drawingRoutine;
 	bool _helmet;
 	int _x, _y, _shade, _burn;
@@ -106,9 +153,15 @@ private:
 	void blitItem(Part& item);
 	/// Blit body sprite.
 	void blitBody(Part& body);
+	/// Calls the drawing routine of the unit.
+	void drawBody();
+	/// Checks if the unit can be drawn from the cache.
+	bool isCacheable() const;
+	/// Gets the cache key of the unit.
+	UnitSpriteCache::Key getCacheKey() const;
 public:
 	/// Creates a new UnitSprite at the specified position and size.
-	UnitSprite(Surface* dest, const Mod* mod, const SavedBattleGame* save, int frame, bool helmet);
+	UnitSprite(Surface* dest, const Mod* mod, const SavedBattleGame* save, int frame, bool helmet, UnitSpriteCache *cache = nullptr);
 	/// Cleans up the UnitSprite.
 	~UnitSprite();
 	/// Draws the unit.
@@ -18,6 +18,7 @@
  */
 #include "AdlibMusic.h"
 #include <algorithm>
+#include <vector>
 #include "Options.h"
 #include "Logger.h"
 #include "Game.h"
@@ -35,6 +36,57 @@ int AdlibMusic::delay = 0;
 int AdlibMusic::rate = 0;
 std::map<int, int> AdlibMusic::delayRates;
 
+namespace
+{
+
+/// Number of tracks kept in the PCM cache.
+const size_t MaxCachedTracks = 3;
+
+/// Longest stretch of a track rendered into the PCM cache, in seconds.
+const int MaxRenderSeconds = 600;
+
+/**
+ * PCM rendering of an Adlib track, stored in one second chunks
+ * so the audio callback can play it while it is still being rendered.
+ */
+struct AdlibRender
+{
+	const AdlibMusic *music;
+	int rate;
+	/// Samples in a chunk, both channels together.
+	int chunkSamples;
+	std::vector<Sint16*> chunks;
+	/// Samples rendered so far, guarded by the render lock.
+	size_t samples;
+	/// Whether the rendering is complete, guarded by the render lock.
+	bool finished;
+	unsigned int lastUsed;
+
+	AdlibRender(const AdlibMusic *music_, int rate_) : music(music_), rate(rate_), chunkSamples(rate_ * 2), chunks(MaxRenderSeconds, nullptr), samples(0), finished(false), lastUsed(0)
+	{
+	}
+	~AdlibRender()
+	{
+		for (auto* chunk : chunks)
+		{
+			delete[] chunk;
+		}
+	}
+};
+
+std::vector<AdlibRender*> renders;
+AdlibRender *playing = 0;
+size_t playPosition = 0;
+/// Length and remainder of the cached playback fade out in samples, guarded by the audio lock.
+size_t fadeSamples = 0, fadeLeft = 0;
+AdlibRender *rendering = 0;
+bool renderQuit = false;
+SDL_Thread *renderThread = 0;
+SDL_mutex *renderLock = 0;
+unsigned int renderUses = 0;
+
+}
+
 /**
  * Initializes a new music track.
  * @param volume Music volume modifier (1.0 = 100%).
@@ -68,6 +120,7 @@ AdlibMusic::AdlibMusic(float volume) : Music(), _data(0), _size(0), _volume(volu
  */
 AdlibMusic::~AdlibMusic()
 {
+	forgetCachedTrack();
 	if (opl[0])
 	{
 		stop();
@@ -113,6 +166,11 @@ void AdlibMusic::play(int) const
 	if (!Options::mute)
 	{
 		stop();
+		if (Options::oxceAdlibCache)
+		{
+			playCachedTrack();
+			return;
+		}
 		func_setup_music((unsigned char*)_data, _size);
 		func_set_music_volume(127 * _volume);
 		Mix_HookMusic(player, (void*)this);
@@ -120,6 +178,261 @@ void AdlibMusic::play(int) const
 #endif
 }
 
+/**
+ * Plays the track from the PCM cache, rendering it
+ * in the background first if it's not there yet.
+ * The track is played while it's being rendered,
+ * which is many times faster than playing it.
+ */
+void AdlibMusic::playCachedTrack() const
+{
+	if (!renderLock)
+	{
+		renderLock = SDL_CreateMutex();
+	}
+	SDL_LockAudio();
+	playing = 0;
+	playPosition = 0;
+	fadeSamples = 0;
+	fadeLeft = 0;
+	SDL_UnlockAudio();
+
+	AdlibRender *render = 0;
+	for (auto* r : renders)
+	{
+		if (r->music == this && r->rate == rate)
+		{
+			render = r;
+			break;
+		}
+	}
+	if (render == 0)
+	{
+		// only finished renderings are left, stop() cancels the others
+		while (renders.size() >= MaxCachedTracks)
+		{
+			auto oldest = std::min_element(renders.begin(), renders.end(), [](const AdlibRender *a, const AdlibRender *b) { return a->lastUsed < b->lastUsed; });
+			delete *oldest;
+			renders.erase(oldest);
+		}
+		render = new AdlibRender(this, rate);
+		renders.push_back(render);
+
+		rendering = render;
+		renderQuit = false;
+		renderThread = SDL_CreateThread(renderTrack, (void*)render);
+		if (renderThread == 0)
+		{
+			Log(LOG_WARNING) << "Failed to start music rendering thread";
+			renders.pop_back();
+			delete render;
+			rendering = 0;
+			return;
+		}
+	}
+	render->lastUsed = ++renderUses;
+	playing = render;
+	Mix_HookMusic(player, (void*)this);
+}
+
+/**
+ * Stops rendering a track into the PCM cache and drops
+ * what was rendered of it, as it's not complete.
+ */
+void AdlibMusic::cancelRender()
+{
+	if (renderThread == 0)
+	{
+		return;
+	}
+	SDL_LockMutex(renderLock);
+	renderQuit = true;
+	SDL_UnlockMutex(renderLock);
+	SDL_WaitThread(renderThread, 0);
+	renderThread = 0;
+
+	if (!rendering->finished)
+	{
+		if (playing == rendering)
+		{
+			Mix_HookMusic(NULL, NULL);
+			playing = 0;
+		}
+		renders.erase(std::find(renders.begin(), renders.end(), rendering));
+		delete rendering;
+	}
+	rendering = 0;
+}
+
+/**
+ * Fades out the music currently playing. The cached track
+ * is faded on playback, so the player state that the
+ * render thread is working with is left alone.
+ * @param ms Length of the fade in milliseconds.
+ */
+void AdlibMusic::fade(int ms)
+{
+#ifndef __NO_MUSIC
+	if (!Options::oxceAdlibCache)
+	{
+		func_fade();
+		return;
+	}
+	SDL_LockAudio();
+	if (playing != 0 && fadeSamples == 0)
+	{
+		fadeSamples = std::max<size_t>((size_t)playing->rate * 2 * ms / 1000, 1);
+		fadeLeft = fadeSamples;
+	}
+	SDL_UnlockAudio();
+#endif
+}
+
+/**
+ * Drops the cached PCM of this track, stopping it first
+ * if it's being rendered or played.
+ */
+void AdlibMusic::forgetCachedTrack()
+{
+	if (rendering && rendering->music == this)
+	{
+		cancelRender();
+	}
+	if (playing && playing->music == this)
+	{
+		Mix_HookMusic(NULL, NULL);
+		playing = 0;
+	}
+	for (auto i = renders.begin(); i != renders.end();)
+	{
+		if ((*i)->music == this)
+		{
+			delete *i;
+			i = renders.erase(i);
+		}
+		else
+		{
+			++i;
+		}
+	}
+	if (renders.empty() && renderLock)
+	{
+		SDL_DestroyMutex(renderLock);
+		renderLock = 0;
+	}
+}
+
+/**
+ * Entry point of the rendering thread. Runs the track
+ * through the player the same way the audio callback does,
+ * until it ends or the rendering is cancelled.
+ * @param render Pointer to the rendering to fill.
+ * @return Thread exit code.
+ */
+int AdlibMusic::renderTrack(void *render)
+{
+	AdlibRender *r = (AdlibRender*)render;
+	func_setup_music((unsigned char*)r->music->_data, r->music->_size);
+	func_set_music_volume(127 * r->music->_volume);
+
+	int tickDelay = 0;
+	for (auto& chunk : r->chunks)
+	{
+		Sint16 *buffer = new Sint16[r->chunkSamples];
+		int len = r->chunkSamples * 2, filled = 0;
+		while (len != 0 && func_is_music_playing())
+		{
+			int i = std::min(tickDelay, len);
+			if (i)
+			{
+				YM3812UpdateOne(opl[0], (INT16*)buffer + filled, i / 2, 2, 1.0f);
+				YM3812UpdateOne(opl[1], (INT16*)buffer + filled + 1, i / 2, 2, 1.0f);
+				filled += i / 2;
+				tickDelay -= i;
+				len -= i;
+			}
+			if (!len)
+				break;
+			func_play_tick();
+
+			tickDelay = delayRates[r->rate];
+		}
+
+		SDL_LockMutex(renderLock);
+		chunk = buffer;
+		r->samples += filled;
+		bool quit = renderQuit || !func_is_music_playing();
+		SDL_UnlockMutex(renderLock);
+		if (quit)
+			break;
+	}
+	func_mute();
+
+	SDL_LockMutex(renderLock);
+	r->finished = !renderQuit;
+	SDL_UnlockMutex(renderLock);
+	return 0;
+}
+
+/**
+ * Copies the current track from the PCM cache to the audio stream,
+ * looping it if needed. Whatever isn't rendered yet stays silent.
+ * @param stream Raw audio to output.
+ * @param len Length of audio to output.
+ */
+void AdlibMusic::playCached(Uint8 *stream, int len)
+{
+	AdlibRender *r = playing;
+	if (r == 0)
+		return;
+	SDL_LockMutex(renderLock);
+	size_t samples = r->samples;
+	bool finished = r->finished;
+	SDL_UnlockMutex(renderLock);
+
+	float volume = Game::volumeExponent(Options::musicVolume);
+	Sint16 *out = (Sint16*)stream;
+	size_t count = len / 2;
+	while (count != 0)
+	{
+		if (fadeSamples != 0 && fadeLeft == 0)
+		{
+			playing = 0;
+			return;
+		}
+		if (playPosition >= samples)
+		{
+			if (finished && samples != 0 && Options::musicAlwaysLoop)
+			{
+				playPosition = 0;
+				continue;
+			}
+			return;
+		}
+		const Sint16 *chunk = r->chunks[playPosition / r->chunkSamples];
+		size_t offset = playPosition % r->chunkSamples;
+		size_t n = std::min(count, std::min(r->chunkSamples - offset, samples - playPosition));
+		if (fadeSamples != 0)
+		{
+			n = std::min(n, fadeLeft);
+		}
+		for (size_t i = 0; i < n; ++i)
+		{
+			if (fadeSamples != 0)
+			{
+				out[i] = chunk[offset + i] * volume * fadeLeft-- / fadeSamples;
+			}
+			else
+			{
+				out[i] = chunk[offset + i] * volume;
+			}
+		}
+		out += n;
+		count -= n;
+		playPosition += n;
+	}
+}
+
 /**
  * Custom audio player.
  * @param udata User data to send to the player.
@@ -132,6 +445,11 @@ void AdlibMusic::player(void *udata, Uint8 *stream, int len)
 	// Check SDL volume for Background Mute functionality
 	if (Options::musicVolume == 0 || Mix_VolumeMusic(-1) == 0)
 		return;
+	if (Options::oxceAdlibCache)
+	{
+		playCached(stream, len);
+		return;
+	}
 	if (Options::musicAlwaysLoop && !func_is_music_playing())
 	{
 		AdlibMusic *music = (AdlibMusic*)udata;
@@ -166,6 +484,10 @@ bool AdlibMusic::isPlaying()
 #ifndef __NO_MUSIC
 	if (!Options::mute)
 	{
+		if (Options::oxceAdlibCache)
+		{
+			return playing != 0;
+		}
 		return func_is_music_playing();
 	}
 #endif
@@ -36,6 +36,15 @@ private:
 	float _volume;
 	static int delay, rate;
 	static std::map<int, int> delayRates;
+
+	/// Renders a track into the PCM cache.
+	static int renderTrack(void *render);
+	/// Plays the current track from the PCM cache.
+	static void playCached(Uint8 *stream, int len);
+	/// Starts playing the track from the PCM cache.
+	void playCachedTrack() const;
+	/// Drops the cached PCM of this track.
+	void forgetCachedTrack();
 public:
 	/// Creates a blank music track.
 	AdlibMusic(float volume = 1.0f);
@@ -49,6 +58,10 @@ public:
 	void play(int loop = -1) const override;
 	/// Adlib music player.
 	static void player(void *udata, Uint8 *stream, int len);
+	/// Stops rendering a track into the PCM cache.
+	static void cancelRender();
+	/// Fades out the music currently playing.
+	static void fade(int ms);
 	bool isPlaying();
 };
 
@@ -79,7 +79,8 @@ enum PlayingState
 	SKIPPED
 };
 
-FlcPlayer::FlcPlayer() : _fileBuf(0), _mainScreen(0), _realScreen(0), _game(0)
+FlcPlayer::FlcPlayer() : _fileSize(0), _filePos(0), _mainScreen(0), _realScreen(0),
+	_frameRead(0), _framesReady(0), _decoderThread(0), _frameLock(0), _frameReady(0), _frameFree(0), _decoderQuit(false), _game(0)
 {
 	_volume = Game::volumeExponent(Options::musicVolume);
 }
@@ -90,7 +91,8 @@ FlcPlayer::~FlcPlayer()
 }
 
 /**
- * Initialize data structures needed buy the player and read the whole file into memory
+ * Initialize data structures needed buy the player and read the file header,
+ * the frames themselves are streamed from the file while playing
  * @param filename Video file name
  * @param frameCallback Function to call each video frame
  * @param game Pointer to the Game instance
@@ -99,7 +101,7 @@ FlcPlayer::~FlcPlayer()
  */
 bool FlcPlayer::init(const char *filename, void(*frameCallBack)(), Game *game, bool useInternalAudio, int dx, int dy)
 {
-	if (_fileBuf != 0)
+	if (_file)
 	{
 		Log(LOG_ERROR) << "Trying to init a video player that is already initialized";
 		return false;
@@ -114,24 +116,26 @@ bool FlcPlayer::init(const char *filename, void(*frameCallBack)(), Game *game, b
 	_dy = dy;
 
 	_fileSize = 0;
+	_filePos = 0;
 	_frameCount = 0;
-	_audioFrameData = 0;
 	_hasAudio = false;
+	_videoDelay = 0;
 	_audioData.loadingBuffer = 0;
 	_audioData.playingBuffer = 0;
 
-	auto file = FileMap::getIStream(filename);
-	file->seekg(0, std::istream::end);
-	auto size = file->tellg();
-	file->seekg(0, std::istream::beg);
-	_fileBuf = new Uint8[size];
-	_fileSize = size;
-	file->read((char *)_fileBuf, size);
-
-	_audioFrameData = _fileBuf + 128;
+	_file = FileMap::getIStream(filename);
+	_file->seekg(0, std::istream::end);
+	_fileSize = _file->tellg();
+	_file->seekg(0, std::istream::beg);
 
 	// Let's read the first 128 bytes
-	readFileHeader();
+	Uint8 header[128];
+	if (!readFile(header, sizeof(header)))
+	{
+		Log(LOG_ERROR) << "Flx file is too short.";
+		return false;
+	}
+	readFileHeader(header);
 
 	// If it's a FLC or FLI file, it's ok
 	if (_headerType == SDL_SwapLE16(FLI_TYPE) || (_headerType == SDL_SwapLE16(FLC_TYPE)))
@@ -139,6 +143,7 @@ bool FlcPlayer::init(const char *filename, void(*frameCallBack)(), Game *game, b
 		_screenWidth = _headerWidth;
 		_screenHeight = _headerHeight;
 		_screenDepth = 8;
+		_canvas.assign(_screenWidth * _screenHeight, 0);
 
 		Log(LOG_INFO) << "Playing flx, " << _screenWidth << "x" << _screenHeight << ", " << _headerFrames << " frames";
 	}
@@ -179,10 +184,16 @@ void FlcPlayer::deInit()
 		_mainScreen = 0;
 	}
 
-	if (_fileBuf != 0)
+	if (_file)
 	{
-		delete[] _fileBuf;
-		_fileBuf = 0;
+		stopDecoder();
+		_file.reset();
+		_frameBuf.clear();
+		_frameBuf.shrink_to_fit();
+		_canvas.clear();
+		_canvas.shrink_to_fit();
+		_frames.clear();
+		_audioPackets.clear();
 
 		deInitAudio();
 	}
@@ -195,21 +206,14 @@ void FlcPlayer::play(bool skipLastFrame)
 {
 	_playingState = PLAYING;
 
-	// Vertically center the video
-	_dy = (_mainScreen->h - _headerHeight) / 2;
-
-	_offset = _dy * _mainScreen->pitch + _mainScreen->format->BytesPerPixel * _dx;
-
-	// Skip file header
-	_videoFrameData = _fileBuf + 128;
-	_audioFrameData = _videoFrameData;
+	startDecoder();
 
 	while (!shouldQuit())
 	{
 		if (_frameCallBack)
 			(*_frameCallBack)();
 		else // TODO: support both, in the case the callback is not some audio?
-			decodeAudio(2);
+			decodeAudio();
 
 		if (!shouldQuit())
 			decodeVideo(skipLastFrame);
@@ -218,6 +222,225 @@ void FlcPlayer::play(bool skipLastFrame)
 			SDLPolling();
 	}
 
+	stopDecoder();
+}
+
+/**
+ * Starts the thread decoding frames ahead of presentation
+ * into a small ring of ready frames.
+ */
+void FlcPlayer::startDecoder()
+{
+	_frames.resize(FRAME_RING_SIZE);
+	for (auto& frame : _frames)
+	{
+		frame.pixels.resize(_canvas.size());
+	}
+	_frameRead = 0;
+	_framesReady = 0;
+	_decoderQuit = false;
+
+	_frameLock = SDL_CreateMutex();
+	_frameReady = SDL_CreateCond();
+	_frameFree = SDL_CreateCond();
+	_decoderThread = SDL_CreateThread(decoderThread, (void*)this);
+	if (_decoderThread == 0)
+	{
+		// If we can't create the thread, just decode every frame right before showing it
+		Log(LOG_WARNING) << "Failed to start video decoding thread";
+	}
+}
+
+/**
+ * Stops the decoding thread, waiting for it to finish the current frame.
+ */
+void FlcPlayer::stopDecoder()
+{
+	if (_decoderThread != 0)
+	{
+		SDL_LockMutex(_frameLock);
+		_decoderQuit = true;
+		SDL_CondBroadcast(_frameFree);
+		SDL_UnlockMutex(_frameLock);
+		SDL_WaitThread(_decoderThread, 0);
+		_decoderThread = 0;
+	}
+	if (_frameLock != 0)
+	{
+		SDL_DestroyCond(_frameFree);
+		SDL_DestroyCond(_frameReady);
+		SDL_DestroyMutex(_frameLock);
+		_frameFree = 0;
+		_frameReady = 0;
+		_frameLock = 0;
+	}
+}
+
+/**
+ * Entry point of the decoding thread.
+ * @param player Pointer to the player.
+ * @return Thread exit code.
+ */
+int FlcPlayer::decoderThread(void *player)
+{
+	return ((FlcPlayer*)player)->decodeFrames();
+}
+
+/**
+ * Decodes frames into free slots of the ring until the end of the file,
+ * sleeping whenever all slots are waiting for presentation.
+ * @return Thread exit code.
+ */
+int FlcPlayer::decodeFrames()
+{
+	size_t write = 0;
+	bool end = false;
+	while (!end)
+	{
+		SDL_LockMutex(_frameLock);
+		while (_framesReady == _frames.size() && !_decoderQuit)
+		{
+			SDL_CondWait(_frameFree, _frameLock);
+		}
+		bool quit = _decoderQuit;
+		SDL_UnlockMutex(_frameLock);
+		if (quit)
+		{
+			break;
+		}
+
+		// the slot isn't visible to the presenting side until it's counted as ready
+		VideoFrame &frame = _frames[write];
+		decodeFrame(frame);
+		end = frame.end;
+
+		SDL_LockMutex(_frameLock);
+		++_framesReady;
+		SDL_CondSignal(_frameReady);
+		SDL_UnlockMutex(_frameLock);
+
+		write = (write + 1) % _frames.size();
+	}
+	return 0;
+}
+
+/**
+ * Reads the file up to the next video frame and decodes it.
+ * Audio chunks found on the way are queued for the presenting side.
+ * @param frame Ring slot to decode the frame into.
+ */
+void FlcPlayer::decodeFrame(VideoFrame &frame)
+{
+	frame.last = false;
+	frame.end = false;
+	_colorsFirst = 256;
+	_colorsLast = 0;
+
+	const Uint32 headerSize = 6;
+	if (_frameBuf.size() < headerSize)
+	{
+		_frameBuf.resize(headerSize);
+	}
+
+	while (true)
+	{
+		if (isEndOfFile() || !readFile(_frameBuf.data(), headerSize) || !isValidFrame(_frameBuf.data(), _videoFrameSize, _videoFrameType))
+		{
+			frame.end = true;
+			return;
+		}
+
+		// audio chunk size doesn't include its 16 byte header, others do
+		Uint32 size = _videoFrameType == AUDIO_CHUNK ? _videoFrameSize + 16 : _videoFrameSize;
+		if (size < headerSize || size - headerSize > _fileSize - _filePos)
+		{
+			frame.end = true;
+			return;
+		}
+		if (_frameBuf.size() < size)
+		{
+			_frameBuf.resize(size);
+		}
+		if (!readFile(_frameBuf.data() + headerSize, size - headerSize))
+		{
+			frame.end = true;
+			return;
+		}
+		Uint8 *frameData = _frameBuf.data();
+
+		switch (_videoFrameType)
+		{
+		case FRAME_TYPE:
+			readU16(_frameChunks, frameData + 6);
+			readU16(frame.delayOverride, frameData + 8);
+
+			// Skip the frame header, we are not interested in the rest
+			_chunkData = frameData + 16;
+			decodeChunks();
+
+			std::copy(_canvas.begin(), _canvas.end(), frame.pixels.begin());
+			std::copy(_colors, _colors + 256, frame.colors);
+			frame.firstColor = _colorsFirst;
+			frame.numColors = std::max(0, _colorsLast - _colorsFirst);
+			// If this frame is the last one, don't play it
+			frame.last = isEndOfFile();
+			return;
+		case AUDIO_CHUNK:
+			if (!_frameCallBack)
+			{
+				AudioPacket packet;
+				readU16(packet.sampleRate, frameData + 8);
+				packet.samples.assign(frameData + 16, frameData + 16 + _videoFrameSize);
+
+				SDL_LockMutex(_frameLock);
+				_audioPackets.push_back(std::move(packet));
+				SDL_UnlockMutex(_frameLock);
+			}
+			break;
+		case PREFIX_CHUNK:
+			// Just skip it
+			break;
+		}
+	}
+}
+
+/**
+ * Waits for the decoder to provide the next frame.
+ * @return Frame to present.
+ */
+FlcPlayer::VideoFrame *FlcPlayer::waitForFrame()
+{
+	if (_decoderThread == 0)
+	{
+		decodeFrame(_frames[_frameRead]);
+		return &_frames[_frameRead];
+	}
+
+	SDL_LockMutex(_frameLock);
+	while (_framesReady == 0)
+	{
+		SDL_CondWait(_frameReady, _frameLock);
+	}
+	VideoFrame *frame = &_frames[_frameRead];
+	SDL_UnlockMutex(_frameLock);
+	return frame;
+}
+
+/**
+ * Gives the presented frame back to the decoder.
+ */
+void FlcPlayer::releaseFrame()
+{
+	if (_decoderThread == 0)
+	{
+		return;
+	}
+
+	SDL_LockMutex(_frameLock);
+	_frameRead = (_frameRead + 1) % _frames.size();
+	--_framesReady;
+	SDL_CondSignal(_frameFree);
+	SDL_UnlockMutex(_frameLock);
 }
 
 void FlcPlayer::delay(Uint32 milliseconds)
@@ -268,15 +491,28 @@ bool FlcPlayer::shouldQuit()
 	return _playingState == FINISHED || _playingState == SKIPPED;
 }
 
-void FlcPlayer::readFileHeader()
+void FlcPlayer::readFileHeader(const Uint8 *header)
+{
+	readU32(_headerSize, header);
+	readU16(_headerType, header + 4);
+	readU16(_headerFrames, header + 6);
+	readU16(_headerWidth, header + 8);
+	readU16(_headerHeight, header + 10);
+	readU16(_headerDepth, header + 12);
+	readU16(_headerSpeed, header + 16);
+}
+
+/**
+ * Reads the next bytes of the video file.
+ * @param dst Buffer to fill.
+ * @param size Number of bytes to read.
+ * @return True if all bytes were read.
+ */
+bool FlcPlayer::readFile(Uint8 *dst, Uint32 size)
 {
-	readU32(_headerSize, _fileBuf);
-	readU16(_headerType, _fileBuf + 4);
-	readU16(_headerFrames, _fileBuf + 6);
-	readU16(_headerWidth, _fileBuf + 8);
-	readU16(_headerHeight, _fileBuf + 10);
-	readU16(_headerDepth, _fileBuf + 12);
-	readU16(_headerSpeed, _fileBuf + 16);
+	_file->read((char *)dst, size);
+	_filePos += _file->gcount();
+	return (Uint32)_file->gcount() == size;
 }
 
 bool FlcPlayer::isValidFrame(Uint8 *frameHeader, Uint32 &frameSize, Uint16 &frameType)
@@ -287,110 +523,106 @@ bool FlcPlayer::isValidFrame(Uint8 *frameHeader, Uint32 &frameSize, Uint16 &fram
 	return (frameType == FRAME_TYPE || frameType == AUDIO_CHUNK || frameType == PREFIX_CHUNK);
 }
 
-void FlcPlayer::decodeAudio(int frames)
+void FlcPlayer::decodeAudio()
 {
+	std::deque<AudioPacket> packets;
+	SDL_LockMutex(_frameLock);
+	packets.swap(_audioPackets);
+	SDL_UnlockMutex(_frameLock);
 
-	int audioFramesFound = 0;
-
-	while (audioFramesFound < frames && !isEndOfFile(_audioFrameData))
+	for (const auto& packet : packets)
 	{
-		if (!isValidFrame(_audioFrameData, _audioFrameSize, _audioFrameType))
-		{
-			_playingState = FINISHED;
-			break;
-		}
-
-		switch (_audioFrameType)
-		{
-			case FRAME_TYPE:
-			case PREFIX_CHUNK:
-				_audioFrameData += _audioFrameSize;
-				break;
-			case AUDIO_CHUNK:
-				Uint16 sampleRate;
-
-				readU16(sampleRate, _audioFrameData + 8);
-
-				_chunkData = _audioFrameData + 16;
-
-				playAudioFrame(sampleRate);
-
-				_audioFrameData += _audioFrameSize + 16;
-
-				++audioFramesFound;
-
-				break;
-		}
+		_audioFrameSize = packet.samples.size();
+		playAudioFrame(packet.sampleRate, packet.samples.data());
 	}
 }
 
 void FlcPlayer::decodeVideo(bool skipLastFrame)
 {
-	bool videoFrameFound = false;
-
-	while (!videoFrameFound)
+	VideoFrame *frame = waitForFrame();
+	if (frame->end)
 	{
-		if (!isValidFrame(_videoFrameData, _videoFrameSize, _videoFrameType))
-		{
-			_playingState = FINISHED;
-			break;
-		}
+		_playingState = FINISHED;
+		releaseFrame();
+		return;
+	}
 
-		switch (_videoFrameType)
-		{
-		case FRAME_TYPE:
+	// audio read ahead of this frame decides its timing
+	if (!_frameCallBack)
+		decodeAudio();
 
-			Uint32 delay;
+	Uint32 delay;
+	if (_headerType == FLI_TYPE)
+	{
+		delay = frame->delayOverride > 0 ? frame->delayOverride : _headerSpeed * (1000.0 / 70.0);
+	}
+	else if (_useInternalAudio && !_frameCallBack) // this means TFTD videos are playing
+	{
+		delay = _videoDelay;
+	}
+	else
+	{
+		delay = _headerSpeed;
+	}
 
-			readU16(_frameChunks, _videoFrameData + 6);
-			readU16(_delayOverride, _videoFrameData + 8);
+	waitForNextFrame(delay);
 
-			if (_headerType == FLI_TYPE)
-			{
-				delay = _delayOverride > 0 ? _delayOverride : _headerSpeed * (1000.0 / 70.0);
-			}
-			else if (_useInternalAudio && !_frameCallBack) // this means TFTD videos are playing
-			{
-				delay = _videoDelay;
-			}
-			else
-			{
-				delay = _headerSpeed;
-			}
+	if (frame->last)
+		_playingState = FINISHED;
 
-			waitForNextFrame(delay);
+	if(!shouldQuit() || !skipLastFrame)
+		playVideoFrame(*frame);
 
-			// Skip the frame header, we are not interested in the rest
-			_chunkData = _videoFrameData + 16;
+	releaseFrame();
+}
 
-			_videoFrameData += _videoFrameSize;
-			// If this frame is the last one, don't play it
-			if(isEndOfFile(_videoFrameData))
-				_playingState = FINISHED;
+void FlcPlayer::playVideoFrame(const VideoFrame &frame)
+{
+	++_frameCount;
 
-			if(!shouldQuit() || !skipLastFrame)
-				playVideoFrame();
+	if (frame.numColors > 0)
+	{
+		if (_mainScreen != _realScreen->getSurface())
+			SDL_SetColors(_mainScreen, (SDL_Color*)frame.colors + frame.firstColor, frame.firstColor, frame.numColors);
+		_realScreen->setPalette(frame.colors + frame.firstColor, frame.firstColor, frame.numColors, true);
+	}
 
-			videoFrameFound = true;
+	if (SDL_LockSurface(_mainScreen) < 0)
+		return;
 
-			break;
-		case AUDIO_CHUNK:
-			_videoFrameData += _videoFrameSize + 16;
-			break;
-		case PREFIX_CHUNK:
-			// Just skip it
-			_videoFrameData += _videoFrameSize;
+	// Vertically center the video, the display may have been resized since last frame
+	_dy = (_mainScreen->h - _headerHeight) / 2;
+	_offset = std::max(0, _dy) * _mainScreen->pitch + _mainScreen->format->BytesPerPixel * _dx;
 
-			break;
+	int width = std::min(_screenWidth, _mainScreen->w - _dx);
+	int height = std::min(_screenHeight, _mainScreen->h - std::max(0, _dy));
+	if (width > 0)
+	{
+		const Uint8 *pSrc = frame.pixels.data();
+		Uint8 *pDst = (Uint8*)_mainScreen->pixels + _offset;
+		for (int y = 0; y < height; ++y)
+		{
+			memcpy(pDst, pSrc, width);
+			pSrc += _screenWidth;
+			pDst += _mainScreen->pitch;
 		}
 	}
+
+	SDL_UnlockSurface(_mainScreen);
+
+	/* TODO: Track which rectangles have really changed */
+	//SDL_UpdateRect(_mainScreen, 0, 0, 0, 0);
+	if (_mainScreen != _realScreen->getSurface())
+		SDL_BlitSurface(_mainScreen, 0, _realScreen->getSurface(), 0);
+
+	_realScreen->flip();
 }
 
-void FlcPlayer::playVideoFrame()
+/**
+ * Applies all chunks of the current frame to the decoder canvas.
+ */
+void FlcPlayer::decodeChunks()
 {
-	++_frameCount;
-	if (SDL_LockSurface(_mainScreen) < 0)
-		return;
 	int chunkCount = _frameChunks;
 
 	for (int i = 0; i < chunkCount; ++i)
@@ -430,18 +662,9 @@ void FlcPlayer::playVideoFrame()
 
 		_chunkData += _chunkSize;
 	}
-
-	SDL_UnlockSurface(_mainScreen);
-
-	/* TODO: Track which rectangles have really changed */
-	//SDL_UpdateRect(_mainScreen, 0, 0, 0, 0);
-	if (_mainScreen != _realScreen->getSurface())
-		SDL_BlitSurface(_mainScreen, 0, _realScreen->getSurface(), 0);
-
-	_realScreen->flip();
 }
 
-void FlcPlayer::playAudioFrame(Uint16 sampleRate)
+void FlcPlayer::playAudioFrame(Uint16 sampleRate, const Uint8 *samples)
 {
 	/* TFTD audio header (10 bytes)
 	* Uint16 unknown1 - always 0
@@ -479,7 +702,7 @@ void FlcPlayer::playAudioFrame(Uint16 sampleRate)
 
 		for (unsigned int i = 0; i < _audioFrameSize; i++)
 		{
-			loadingBuff->samples[loadingBuff->sampleCount + i] = (float)((_chunkData[i]) -128) * 240 * _volume;
+			loadingBuff->samples[loadingBuff->sampleCount + i] = (float)((samples[i]) -128) * 240 * _volume;
 		}
 		loadingBuff->sampleCount += _audioFrameSize;
 
@@ -513,14 +736,12 @@ void FlcPlayer::color256()
 
 		for (int i = 0; i < numColors; ++i)
 		{
-			_colors[i].r = *(pSrc++);
-			_colors[i].g = *(pSrc++);
-			_colors[i].b = *(pSrc++);
+			SDL_Color &color = _colors[(numColorsSkip + i) & 0xFF];
+			color.r = *(pSrc++);
+			color.g = *(pSrc++);
+			color.b = *(pSrc++);
 		}
-
-		if (_mainScreen != _realScreen->getSurface())
-			SDL_SetColors(_mainScreen, _colors, numColorsSkip, numColors);
-		_realScreen->setPalette(_colors, numColorsSkip, numColors, true);
+		markColors(numColorsSkip, numColors);
 
 		if (numColorPackets >= 1)
 		{
@@ -529,6 +750,18 @@ void FlcPlayer::color256()
 	}
 }
 
+/**
+ * Remembers the palette range changed by the current frame,
+ * the presenting side only uploads that part.
+ * @param first First changed color.
+ * @param count Number of changed colors.
+ */
+void FlcPlayer::markColors(int first, int count)
+{
+	_colorsFirst = std::min(_colorsFirst, first);
+	_colorsLast = std::max(_colorsLast, std::min(256, first + count));
+}
+
 void FlcPlayer::fliSS2()
 {
 	Uint8 *pSrc, *pDst, *pTmpDst;
@@ -540,7 +773,7 @@ void FlcPlayer::fliSS2()
 	Uint8 lastByte = 0;
 
 	pSrc = _chunkData + 6;
-	pDst = (Uint8*)_mainScreen->pixels + _offset;
+	pDst = _canvas.data();
 	readU16(lines, pSrc);
 
 	pSrc += 2;
@@ -552,7 +785,7 @@ void FlcPlayer::fliSS2()
 
 		if ((count & MASK) == SKIP_LINES)
 		{
-			pDst += (-count)*_mainScreen->pitch;
+			pDst += (-count)*_screenWidth;
 			++lines;
 			continue;
 		}
@@ -601,9 +834,9 @@ void FlcPlayer::fliSS2()
 			if (setLastByte)
 			{
 				setLastByte = false;
-				*(pDst + _mainScreen->pitch - 1) = lastByte;
+				*(pDst + _screenWidth - 1) = lastByte;
 			}
-			pDst += _mainScreen->pitch;
+			pDst += _screenWidth;
 		}
 	}
 }
@@ -616,7 +849,7 @@ void FlcPlayer::fliBRun()
 
 	heightCount = _headerHeight;
 	pSrc = _chunkData + 6; // Skip chunk header
-	pDst = (Uint8*)_mainScreen->pixels + _offset;
+	pDst = _canvas.data();
 
 	while (heightCount--)
 	{
@@ -648,7 +881,7 @@ void FlcPlayer::fliBRun()
 				}
 			}
 		}
-		pDst += _mainScreen->pitch;
+		pDst += _screenWidth;
 	}
 }
 
@@ -663,11 +896,11 @@ void FlcPlayer::fliLC()
 	int packetsCount;
 
 	pSrc = _chunkData + 6;
-	pDst = (Uint8*)_mainScreen->pixels + _offset;
+	pDst = _canvas.data();
 
 	readU16(tmp, pSrc);
 	pSrc += 2;
-	pDst += tmp*_mainScreen->pitch;
+	pDst += tmp*_screenWidth;
 	readU16(lines, pSrc);
 	pSrc += 2;
 
@@ -702,7 +935,7 @@ void FlcPlayer::fliLC()
 				}
 			}
 		}
-		pDst += _mainScreen->pitch;
+		pDst += _screenWidth;
 	}
 }
 
@@ -728,14 +961,12 @@ void FlcPlayer::color64()
 
 		for (int i = 0; i < NumColors; ++i)
 		{
-			_colors[i].r = *(pSrc++) << 2;
-			_colors[i].g = *(pSrc++) << 2;
-			_colors[i].b = *(pSrc++) << 2;
+			SDL_Color &color = _colors[(NumColorsSkip + i) & 0xFF];
+			color.r = *(pSrc++) << 2;
+			color.g = *(pSrc++) << 2;
+			color.b = *(pSrc++) << 2;
 		}
-
-		if (_mainScreen != _realScreen->getSurface())
-			SDL_SetColors(_mainScreen, _colors, NumColorsSkip, NumColors);
-		_realScreen->setPalette(_colors, NumColorsSkip, NumColors, true);
+		markColors(NumColorsSkip, NumColors);
 	}
 }
 
@@ -744,13 +975,13 @@ void FlcPlayer::fliCopy()
 	Uint8 *pSrc, *pDst;
 	int Lines = _screenHeight;
 	pSrc = _chunkData + 6;
-	pDst = (Uint8*)_mainScreen->pixels + _offset;
+	pDst = _canvas.data();
 
 	while (Lines--)
 	{
 		memcpy(pDst, pSrc, _screenWidth);
 		pSrc += _screenWidth;
-		pDst += _mainScreen->pitch;
+		pDst += _screenWidth;
 	}
 }
 
@@ -758,12 +989,12 @@ void FlcPlayer::black()
 {
 	Uint8 *pDst;
 	int Lines = _screenHeight;
-	pDst = (Uint8*)_mainScreen->pixels + _offset;
+	pDst = _canvas.data();
 
 	while (Lines-- > 0)
 	{
 		memset(pDst, 0, _screenHeight);
-		pDst += _mainScreen->pitch;
+		pDst += _screenWidth;
 	}
 }
 
@@ -875,9 +1106,9 @@ void FlcPlayer::stop()
 	_playingState = FINISHED;
 }
 
-bool FlcPlayer::isEndOfFile(Uint8 *pos)
+bool FlcPlayer::isEndOfFile() const
 {
-	return (pos - _fileBuf) == (int)(_fileSize); // should be Sint64, but let's assume the videos won't be 2gb
+	return _filePos >= _fileSize; // should be Sint64, but let's assume the videos won't be 2gb
 }
 
 int FlcPlayer::getFrameCount()
@@ -914,10 +1145,9 @@ void FlcPlayer::waitForNextFrame(Uint32 delay)
 	{
 		while (currentTick < newTick)
 		{
-			while ((newTick - currentTick) > 10 && !isEndOfFile(_audioFrameData))
+			if ((newTick - currentTick) > 10)
 			{
-				decodeAudio(1);
-				currentTick = SDL_GetTicks();
+				decodeAudio();
 			}
 			SDL_Delay(1);
 			currentTick = SDL_GetTicks();
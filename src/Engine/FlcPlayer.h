@@ -23,6 +23,10 @@
  * Based on http://www.libsdl.org/projects/flxplay/
  */
 #include <SDL.h>
+#include <deque>
+#include <istream>
+#include <memory>
+#include <vector>
 
 namespace OpenXcom
 {
@@ -34,11 +38,11 @@ class FlcPlayer
 {
 private:
 
-	Uint8 *_fileBuf;
+	std::unique_ptr<std::istream> _file;
 	Uint32 _fileSize;
-	Uint8 *_videoFrameData;
+	Uint32 _filePos;
+	std::vector<Uint8> _frameBuf;
 	Uint8 *_chunkData;
-	Uint8 *_audioFrameData;
 	Uint16 _frameCount;    /* Frame Counter */
 	Uint32 _headerSize;    /* Fli file size */
 	Uint16 _headerType;    /* Fli header check */
@@ -52,15 +56,15 @@ private:
 	Uint16 _frameChunks;   /* Number of chunks in frame */
 	Uint32 _chunkSize;     /* Size of chunk */
 	Uint16 _chunkType;     /* Type of chunk */
-	Uint16 _delayOverride; /* FRAME_TYPE extension */
 	Uint32 _audioFrameSize;
-	Uint16 _audioFrameType;
 
 	void (*_frameCallBack)();
 
 	SDL_Surface *_mainScreen;
 	Screen *_realScreen;
 	SDL_Color _colors[256];
+	int _colorsFirst, _colorsLast;
+	std::vector<Uint8> _canvas;
 	int _screenWidth;
 	int _screenHeight;
 	int _screenDepth;
@@ -91,35 +95,71 @@ private:
 
 	AudioData _audioData;
 
+	/// Decoded video frame waiting for presentation.
+	struct VideoFrame
+	{
+		std::vector<Uint8> pixels;
+		SDL_Color colors[256];
+		int firstColor, numColors;
+		Uint16 delayOverride;
+		bool last, end;
+	};
+
+	/// Audio chunk read ahead by the decoder.
+	struct AudioPacket
+	{
+		Uint16 sampleRate;
+		std::vector<Uint8> samples;
+	};
+
+	static const size_t FRAME_RING_SIZE = 4;
+	std::vector<VideoFrame> _frames;
+	size_t _frameRead, _framesReady;
+	std::deque<AudioPacket> _audioPackets;
+	SDL_Thread *_decoderThread;
+	SDL_mutex *_frameLock;
+	SDL_cond *_frameReady, *_frameFree;
+	bool _decoderQuit;
+
 	Game *_game;
 
 	void readU16(Uint16 &dst, const Uint8 *const src);
 	void readU32(Uint32 &dst, const Uint8 *const src);
 	void readS16(Sint16 &dst, const Sint8 *const src);
 	void readS32(Sint32 &dst, const Sint8 *const src);
-	void readFileHeader();
+	void readFileHeader(const Uint8 *header);
 
 	bool isValidFrame(Uint8 *frameHeader, Uint32 &frameSize, Uint16 &frameType);
+	bool readFile(Uint8 *dst, Uint32 size);
+	void startDecoder();
+	void stopDecoder();
+	static int decoderThread(void *player);
+	int decodeFrames();
+	void decodeFrame(VideoFrame &frame);
+	VideoFrame *waitForFrame();
+	void releaseFrame();
 	void decodeVideo(bool skipLastFrame);
-	void decodeAudio(int frames);
+	void decodeAudio();
 	void waitForNextFrame(Uint32 delay);
 	void SDLPolling();
 	bool shouldQuit();
 
-	void playVideoFrame();
+	void playVideoFrame(const VideoFrame &frame);
+	void decodeChunks();
 	void color256();
 	void fliBRun();
 	void fliCopy();
 	void fliSS2();
 	void fliLC();
 	void color64();
+	void markColors(int first, int count);
 	void black();
 
-	void playAudioFrame(Uint16 sampleRate);
+	void playAudioFrame(Uint16 sampleRate, const Uint8 *samples);
 	void initAudio(Uint16 format, Uint8 channels);
 	void deInitAudio();
 
-	bool isEndOfFile(Uint8 *pos);
+	bool isEndOfFile() const;
 
 	static void audioCallback(void *userData, Uint8 *stream, int len);
 
@@ -128,7 +168,7 @@ public:
 	FlcPlayer();
 	~FlcPlayer();
 
-	/// Open FLC or FLI file, read header, prepare to play it
+	/// Open FLC or FLI file, read header, prepare to stream it
 	bool init(const char *filename, void(*frameCallBack)(), Game *game, bool useAudio, int dx, int dy);
 	/// Play the loaded file; set flc.mainScreen first!
 	void play(bool skipLastFrame);
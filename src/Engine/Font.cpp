@@ -21,6 +21,7 @@
 #include "Surface.h"
 #include "FileMap.h"
 #include "Unicode.h"
+#include "../Interface/Text.h"
 
 namespace OpenXcom
 {
@@ -39,6 +40,8 @@ Font::Font() : _monospace(false)
  */
 Font::~Font()
 {
+	// cached text layouts are keyed by font pointer
+	Text::clearLayoutCache();
 	for (auto& fontImage : _images)
 	{
 		delete fontImage.surface;
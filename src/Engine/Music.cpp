@@ -106,6 +106,7 @@ void Music::stop()
 #ifndef __NO_MUSIC
 	if (!Options::mute)
 	{
+		AdlibMusic::cancelRender();
 		func_mute();
 		Mix_HookMusic(NULL, NULL);
 		Mix_HaltMusic();
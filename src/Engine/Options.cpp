@@ -56,6 +56,13 @@ std::string _masterMod;
 int _passwordCheck = -1;
 bool _loadLastSave = false;
 bool _loadLastSaveExpended = false;
+std::string _benchmarkSave;
+int _benchmarkTurns = 10;
+std::string _benchmarkSeed;
+std::string _simulateSave;
+int _simulateMonths = 12;
+std::string _simulateSeed;
+bool _simulateCompare = false;
 
 /**
  * Sets up the options by creating their OptionInfo metadata.
@@ -242,6 +249,11 @@ void create()
 	_info.push_back(OptionInfo("oxceEnableUnitResponseSounds", &oxceEnableUnitResponseSounds, true));
 	_info.push_back(OptionInfo("oxceEnableSlackingIndicator", &oxceEnableSlackingIndicator, true));
 	_info.push_back(OptionInfo("oxceEnablePaletteFlickerFix", &oxceEnablePaletteFlickerFix, false));
+	_info.push_back(OptionInfo("oxcePresentThread", &oxcePresentThread, false));
+	_info.push_back(OptionInfo("oxceAdlibCache", &oxceAdlibCache, false));
+	_info.push_back(OptionInfo("oxceSoundCacheSize", &oxceSoundCacheSize, 0)); // MB of decoded sounds, 0 = decode all at load
+	_info.push_back(OptionInfo("oxceSpriteAtlas", &oxceSpriteAtlas, false));
+	_info.push_back(OptionInfo("oxceSpriteSpans", &oxceSpriteSpans, false));
 	_info.push_back(OptionInfo("oxceMaxEquipmentLayoutTemplates", &oxceMaxEquipmentLayoutTemplates, 20));
 	_info.push_back(OptionInfo("oxcePersonalLayoutIncludingArmor", &oxcePersonalLayoutIncludingArmor, true));
 	_info.push_back(OptionInfo("oxceManufactureFilterSuppliesOK", &oxceManufactureFilterSuppliesOK, false));
@@ -537,6 +549,34 @@ static void loadArgs()
 				{
 					_masterMod = argv[i];
 				}
+				else if (argname == "benchmark")
+				{
+					_benchmarkSave = argv[i];
+				}
+				else if (argname == "benchmarkturns")
+				{
+					_benchmarkTurns = std::max(1, atoi(argv[i].c_str()));
+				}
+				else if (argname == "benchmarkseed")
+				{
+					_benchmarkSeed = argv[i];
+				}
+				else if (argname == "simulate")
+				{
+					_simulateSave = argv[i];
+				}
+				else if (argname == "simulatemonths")
+				{
+					_simulateMonths = std::max(1, atoi(argv[i].c_str()));
+				}
+				else if (argname == "simulateseed")
+				{
+					_simulateSeed = argv[i];
+				}
+				else if (argname == "simulatecompare")
+				{
+					_simulateCompare = (argv[i] == "1" || argv[i] == "true");
+				}
 				else
 				{
 					//save this command line option for now, we will apply it later
@@ -569,6 +609,20 @@ static bool showHelp()
 	help << "        use PATH as the default Config Folder instead of auto-detecting" << std::endl << std::endl;
 	help << "-master MOD" << std::endl;
 	help << "        set MOD to the current master mod (eg. -master xcom2)" << std::endl << std::endl;
+	help << "-benchmark SAVE" << std::endl;
+	help << "        play the battle in SAVE (from the user folder) without video, AI controlling all sides, and report timings" << std::endl << std::endl;
+	help << "-benchmarkTurns N" << std::endl;
+	help << "        number of turns to run the benchmark for (default 10)" << std::endl << std::endl;
+	help << "-benchmarkSeed N" << std::endl;
+	help << "        random seed for the benchmark (default: seed stored in SAVE)" << std::endl << std::endl;
+	help << "-simulate SAVE" << std::endl;
+	help << "        play the campaign in SAVE (from the user folder) without video or player, and report score, funds and UFOs each month" << std::endl << std::endl;
+	help << "-simulateMonths N" << std::endl;
+	help << "        number of months to run the simulation for (default 12)" << std::endl << std::endl;
+	help << "-simulateSeed N" << std::endl;
+	help << "        random seed for the simulation (default: seed stored in SAVE)" << std::endl << std::endl;
+	help << "-simulateCompare 1" << std::endl;
+	help << "        play the simulation twice, with and without skipping quiet geoscape steps, and check both end the same" << std::endl << std::endl;
 	help << "-KEY VALUE" << std::endl;
 	help << "        override option KEY with VALUE (eg. -displayWidth 640)" << std::endl << std::endl;
 	help << "-help" << std::endl;
@@ -938,6 +992,70 @@ void expendLoadLastSave()
 	_loadLastSaveExpended = true;
 }
 
+/**
+ * Gets the battle save requested for a benchmark run.
+ * @return Save file name, empty if no benchmark is requested.
+ */
+const std::string &getBenchmarkSave()
+{
+	return _benchmarkSave;
+}
+
+/**
+ * Gets the number of turns a benchmark run lasts.
+ * @return Number of turns.
+ */
+int getBenchmarkTurns()
+{
+	return _benchmarkTurns;
+}
+
+/**
+ * Gets the random seed requested for a benchmark run.
+ * @return Seed, empty to use the one stored in the save.
+ */
+const std::string &getBenchmarkSeed()
+{
+	return _benchmarkSeed;
+}
+
+/**
+ * Gets the campaign save requested for a simulation run.
+ * @return Save file name, empty if no simulation is requested.
+ */
+const std::string &getSimulateSave()
+{
+	return _simulateSave;
+}
+
+/**
+ * Gets the number of months a simulation run lasts.
+ * @return Number of months.
+ */
+int getSimulateMonths()
+{
+	return _simulateMonths;
+}
+
+/**
+ * Gets the random seed requested for a simulation run.
+ * @return Seed, empty to use the one stored in the save.
+ */
+const std::string &getSimulateSeed()
+{
+	return _simulateSeed;
+}
+
+/**
+ * Gets if a simulation run compares stepping through
+ * every geoscape step with skipping the quiet ones.
+ * @return True to compare.
+ */
+bool getSimulateCompare()
+{
+	return _simulateCompare;
+}
+
 /**
  * Sets up the game's Data folder where the data files
  * are loaded from and the User folder and Config
@@ -122,6 +122,20 @@ namespace Options
 	bool getLoadLastSave();
 	/// And do it only at startup
 	void expendLoadLastSave();
+	/// Gets the battle save to benchmark.
+	const std::string &getBenchmarkSave();
+	/// Gets the number of turns to benchmark.
+	int getBenchmarkTurns();
+	/// Gets the random seed to benchmark with.
+	const std::string &getBenchmarkSeed();
+	/// Gets the campaign save to simulate.
+	const std::string &getSimulateSave();
+	/// Gets the number of months to simulate.
+	int getSimulateMonths();
+	/// Gets the random seed to simulate with.
+	const std::string &getSimulateSeed();
+	/// Gets if the simulation checks skipped steps against stepped ones.
+	bool getSimulateCompare();
 }
 
 }
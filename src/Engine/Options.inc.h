@@ -89,6 +89,11 @@ OPT int oxceInterceptGuiMaintenanceTimeHidden;
 OPT bool oxceEnableUnitResponseSounds;
 OPT bool oxceEnableSlackingIndicator;
 OPT bool oxceEnablePaletteFlickerFix;
+OPT bool oxcePresentThread;
+OPT bool oxceAdlibCache;
+OPT int oxceSoundCacheSize;
+OPT bool oxceSpriteAtlas;
+OPT bool oxceSpriteSpans;
 OPT int oxceMaxEquipmentLayoutTemplates;
 OPT bool oxcePersonalLayoutIncludingArmor;
 OPT bool oxceManufactureFilterSuppliesOK;
@@ -0,0 +1,161 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "Parallel.h"
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <vector>
+#include <SDL_thread.h>
+
+namespace OpenXcom
+{
+
+namespace Parallel
+{
+
+namespace
+{
+
+/// Most threads used, more than this doesn't pay off for the jobs we have.
+const int MaxThreads = 8;
+
+/// Shared state of the threads running a job.
+struct Work
+{
+	void (*job)(void *data, int index);
+	void *data;
+	int count;
+	int next;
+	SDL_mutex *lock;
+	std::exception_ptr error;
+};
+
+/**
+ * Takes the next index nobody has worked on yet.
+ * @param work Shared state.
+ * @return Index, or -1 if there is nothing left or a job failed.
+ */
+int takeIndex(Work &work)
+{
+	SDL_LockMutex(work.lock);
+	int index = (work.next < work.count && !work.error) ? work.next++ : -1;
+	SDL_UnlockMutex(work.lock);
+	return index;
+}
+
+/**
+ * Runs jobs until none are left.
+ * @param work Shared state.
+ */
+void runJobs(Work &work)
+{
+	for (int index = takeIndex(work); index != -1; index = takeIndex(work))
+	{
+		try
+		{
+			work.job(work.data, index);
+		}
+		catch (...)
+		{
+			SDL_LockMutex(work.lock);
+			if (!work.error)
+			{
+				work.error = std::current_exception();
+			}
+			SDL_UnlockMutex(work.lock);
+		}
+	}
+}
+
+/**
+ * Entry point of the helper threads.
+ * @param data Pointer to the shared state.
+ * @return Always zero.
+ */
+int workerThread(void *data)
+{
+	runJobs(*static_cast<Work*>(data));
+	return 0;
+}
+
+}
+
+/**
+ * Gets the number of threads used for parallel jobs,
+ * based on the number of processor cores.
+ * @return Number of threads, including the calling one.
+ */
+int getThreadCount()
+{
+	static const int threads = std::max(1, std::min<int>(std::thread::hardware_concurrency(), MaxThreads));
+	return threads;
+}
+
+/**
+ * Runs a job for every index from 0 to count - 1 on several threads,
+ * the calling thread included, and waits for all of them to finish.
+ * Small counts or single core machines just run the jobs in order.
+ * @param count Number of indices.
+ * @param job Function to run.
+ * @param data Data passed to the function.
+ */
+void run(int count, void (*job)(void *data, int index), void *data)
+{
+	int threads = std::min(count, getThreadCount());
+	if (threads <= 1)
+	{
+		for (int i = 0; i < count; ++i)
+		{
+			job(data, i);
+		}
+		return;
+	}
+
+	Work work;
+	work.job = job;
+	work.data = data;
+	work.count = count;
+	work.next = 0;
+	work.lock = SDL_CreateMutex();
+
+	std::vector<SDL_Thread*> helpers;
+	for (int i = 1; i < threads; ++i)
+	{
+		SDL_Thread *thread = SDL_CreateThread(workerThread, (void*)&work);
+		if (thread)
+		{
+			helpers.push_back(thread);
+		}
+	}
+	runJobs(work);
+	for (auto* thread : helpers)
+	{
+		SDL_WaitThread(thread, 0);
+	}
+	SDL_DestroyMutex(work.lock);
+
+	if (work.error)
+	{
+		std::rethrow_exception(work.error);
+	}
+}
+
+}
+
+}
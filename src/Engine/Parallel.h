@@ -0,0 +1,52 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <type_traits>
+
+namespace OpenXcom
+{
+
+/**
+ * Spreads independent jobs over several threads.
+ * Jobs must not touch anything another job can touch,
+ * and must not use the global random generator.
+ */
+namespace Parallel
+{
+	/// Gets how many threads jobs are spread over.
+	int getThreadCount();
+	/// Runs a job for every index, returns when all are done.
+	void run(int count, void (*job)(void *data, int index), void *data);
+
+	/**
+	 * Calls a function for every index from 0 to count - 1,
+	 * in no particular order, and waits for all calls to finish.
+	 * The first exception thrown by a call is rethrown here.
+	 * @param count Number of indices.
+	 * @param func Function taking the index.
+	 */
+	template<typename F>
+	void forEach(int count, F &&func)
+	{
+		using Func = typename std::remove_reference<F>::type;
+		run(count, [](void *data, int index) { (*static_cast<Func*>(data))(index); }, (void*)&func);
+	}
+}
+
+}
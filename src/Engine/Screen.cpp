@@ -112,7 +112,8 @@ void Screen::makeVideoFlags()
  * Initializes a new display screen for the game to render contents to.
  * The screen is set up based on the current options.
  */
-Screen::Screen() : _baseWidth(ORIGINAL_WIDTH), _baseHeight(ORIGINAL_HEIGHT), _scaleX(1.0), _scaleY(1.0), _flags(0), _numColors(0), _firstColor(0), _pushPalette(false), _flickerFix(false)
+Screen::Screen() : _baseWidth(ORIGINAL_WIDTH), _baseHeight(ORIGINAL_HEIGHT), _scaleX(1.0), _scaleY(1.0), _flags(0), _numColors(0), _firstColor(0), _pushPalette(false), _flickerFix(false),
+	_frameQueued(false), _frameReady(false), _presentStop(false), _presentThread(0), _presentLock(0), _presentCond(0)
 {
 	_flickerFix = Options::oxceEnablePaletteFlickerFix;
 
@@ -126,7 +127,7 @@ Screen::Screen() : _baseWidth(ORIGINAL_WIDTH), _baseHeight(ORIGINAL_HEIGHT), _sc
  */
 Screen::~Screen()
 {
-
+	stopPresentThread();
 }
 
 /**
@@ -187,55 +188,254 @@ void Screen::handle(Action *action)
  * If the scaling factor is bigger than 1, the entire contents
  * of the buffer are resized by that factor (eg. 2 = doubled)
  * before being put on screen.
+ * With the present thread running, the buffer is only copied and
+ * scaled while the game goes on with the next frame, then put on
+ * screen by the next flip.
  */
 void Screen::flip()
+{
+	int numColors = 0;
+	if (_pushPalette && _numColors && _screen->format->BitsPerPixel == 8)
+	{
+		numColors = _numColors;
+		_numColors = 0;
+		_pushPalette = false;
+	}
+
+	if (!_presentThread)
+	{
+		present(_surface.get(), 0, deferredPalette, _firstColor, numColors);
+		return;
+	}
+
+	// show the frame scaled meanwhile, this also frees the frame slot
+	finishPresent();
+
+	// nobody else touches the frame while it isn't queued
+	memcpy(_frame.surface->pixels, _surface->pixels, _surface->pitch * _surface->h);
+	if (_surface->format->BitsPerPixel == 8)
+	{
+		SDL_SetColors(_frame.surface.get(), _surface->format->palette->colors, 0, 256);
+		SDL_SetColors(_frame.scaled.get(), _surface->format->palette->colors, 0, 256);
+	}
+	memcpy(_frame.palette, deferredPalette, sizeof(deferredPalette));
+	_frame.firstColor = _firstColor;
+	_frame.numColors = numColors;
+
+	SDL_LockMutex(_presentLock);
+	_frameQueued = true;
+	SDL_CondBroadcast(_presentCond);
+	SDL_UnlockMutex(_presentLock);
+}
+
+/**
+ * Puts a frame on the display: applies the requested palette
+ * change, scales the frame onto the display surface and flips it.
+ * Like every SDL video call, this only runs on the main thread.
+ * @param frame Surface with the frame, the size of the buffer.
+ * @param scaled Surface with the frame already scaled to the display size, or 0 to scale it here.
+ * @param palette Full 256 color palette.
+ * @param firstColor First color of the palette to push to the display.
+ * @param numColors Number of colors to push, 0 for none.
+ */
+void Screen::present(SDL_Surface *frame, SDL_Surface *scaled, const SDL_Color *palette, int firstColor, int numColors)
 {
 	// perform any requested palette update
-	if (_flickerFix && _pushPalette && _numColors && _screen->format->BitsPerPixel == 8)
+	if (_flickerFix && numColors)
 	{
-		if (_screen->format->BitsPerPixel == 8 && SDL_SetColors(_screen, &(deferredPalette[_firstColor]), _firstColor, _numColors) == 0)
+		if (SDL_SetColors(_screen, const_cast<SDL_Color*>(&palette[firstColor]), firstColor, numColors) == 0)
 		{
 			Log(LOG_DEBUG) << "Display palette doesn't match requested palette";
 		}
-		_numColors = 0;
-		_pushPalette = false;
 	}
 
-	if (getWidth() != _baseWidth || getHeight() != _baseHeight || useOpenGL())
+	if (scaled)
 	{
-		Zoom::flipWithZoom(_surface.get(), _screen, _topBlackBand, _bottomBlackBand, _leftBlackBand, _rightBlackBand, &glOutput);
+		SDL_BlitSurface(scaled, 0, _screen, 0);
 	}
 	else
 	{
-		SDL_BlitSurface(_surface.get(), 0, _screen, 0);
+		scaleFrame(frame, _screen);
 	}
 
 	// perform any requested palette update
-	if (!_flickerFix && _pushPalette && _numColors && _screen->format->BitsPerPixel == 8)
+	if (!_flickerFix && numColors)
 	{
-		if (_screen->format->BitsPerPixel == 8 && SDL_SetColors(_screen, &(deferredPalette[_firstColor]), _firstColor, _numColors) == 0)
+		if (SDL_SetColors(_screen, const_cast<SDL_Color*>(&palette[firstColor]), firstColor, numColors) == 0)
 		{
 			Log(LOG_DEBUG) << "Display palette doesn't match requested palette";
 		}
-		_numColors = 0;
-		_pushPalette = false;
 	}
 
-
-
 	if (SDL_Flip(_screen) == -1)
 	{
 		throw Exception(SDL_GetError());
 	}
 }
 
+/**
+ * Scales a frame to the display size. Only touches the display
+ * when it's the target, so the present thread can scale into
+ * a surface of its own.
+ * @param frame Surface with the frame, the size of the buffer.
+ * @param target Surface the size and format of the display.
+ */
+void Screen::scaleFrame(SDL_Surface *frame, SDL_Surface *target)
+{
+	if (getWidth() != _baseWidth || getHeight() != _baseHeight || useOpenGL())
+	{
+		Zoom::flipWithZoom(frame, target, _topBlackBand, _bottomBlackBand, _leftBlackBand, _rightBlackBand, &glOutput);
+	}
+	else
+	{
+		SDL_BlitSurface(frame, 0, target, 0);
+	}
+}
+
+/**
+ * Scales the queued frames one after another until told to stop.
+ * @param data Pointer to the screen.
+ * @return Always zero.
+ */
+int Screen::presentLoop(void *data)
+{
+	Screen *screen = static_cast<Screen*>(data);
+	SDL_LockMutex(screen->_presentLock);
+	while (true)
+	{
+		while (!screen->_frameQueued && !screen->_presentStop)
+		{
+			SDL_CondWait(screen->_presentCond, screen->_presentLock);
+		}
+		if (!screen->_frameQueued)
+		{
+			break;
+		}
+		SDL_UnlockMutex(screen->_presentLock);
+
+		screen->scaleFrame(screen->_frame.surface.get(), screen->_frame.scaled.get());
+
+		SDL_LockMutex(screen->_presentLock);
+		screen->_frameQueued = false;
+		screen->_frameReady = true;
+		SDL_CondBroadcast(screen->_presentCond);
+	}
+	SDL_UnlockMutex(screen->_presentLock);
+	return 0;
+}
+
+/**
+ * Starts a thread to scale the frames, if the options ask for it.
+ * OpenGL needs its context on the main thread, so it always
+ * presents right away.
+ */
+void Screen::startPresentThread()
+{
+	if (!Options::oxcePresentThread || useOpenGL() || _presentThread)
+	{
+		return;
+	}
+
+	if (_surface->format->BitsPerPixel == 32)
+	{
+		std::tie(_frame.buffer, _frame.surface) = Surface::NewPair32Bit(_baseWidth, _baseHeight);
+	}
+	else
+	{
+		std::tie(_frame.buffer, _frame.surface) = Surface::NewPair8Bit(_baseWidth, _baseHeight);
+	}
+	SDL_SetColorKey(_frame.surface.get(), 0, 0);
+	const SDL_PixelFormat *format = _screen->format;
+	_frame.scaled = Surface::NewSdlSurface(SDL_CreateRGBSurface(SDL_SWSURFACE, _screen->w, _screen->h, format->BitsPerPixel, format->Rmask, format->Gmask, format->Bmask, format->Amask));
+	if (!_frame.scaled)
+	{
+		Log(LOG_WARNING) << "Couldn't start the present thread, presenting frames right away: " << SDL_GetError();
+		stopPresentThread();
+		return;
+	}
+
+	_frameQueued = false;
+	_frameReady = false;
+	_presentStop = false;
+	_presentLock = SDL_CreateMutex();
+	_presentCond = SDL_CreateCond();
+	_presentThread = SDL_CreateThread(presentLoop, (void*)this);
+	if (!_presentThread)
+	{
+		Log(LOG_WARNING) << "Couldn't start the present thread, presenting frames right away: " << SDL_GetError();
+		stopPresentThread();
+	}
+}
+
+/**
+ * Stops the present thread. A frame not shown yet is dropped,
+ * it's only stopped before the display changes anyway.
+ */
+void Screen::stopPresentThread()
+{
+	if (_presentThread)
+	{
+		SDL_LockMutex(_presentLock);
+		_presentStop = true;
+		SDL_CondBroadcast(_presentCond);
+		SDL_UnlockMutex(_presentLock);
+		SDL_WaitThread(_presentThread, 0);
+		_presentThread = 0;
+	}
+	if (_presentCond)
+	{
+		SDL_DestroyCond(_presentCond);
+		_presentCond = 0;
+	}
+	if (_presentLock)
+	{
+		SDL_DestroyMutex(_presentLock);
+		_presentLock = 0;
+	}
+	_frameQueued = false;
+	_frameReady = false;
+	_frame.scaled.reset();
+	_frame.surface.reset();
+	_frame.buffer.reset();
+}
+
+/**
+ * Waits until the present thread is done scaling the queued frame
+ * and puts it on the display, before the main thread touches
+ * the display otherwise.
+ */
+void Screen::finishPresent()
+{
+	if (!_presentThread)
+	{
+		return;
+	}
+	SDL_LockMutex(_presentLock);
+	while (_frameQueued)
+	{
+		SDL_CondWait(_presentCond, _presentLock);
+	}
+	bool ready = _frameReady;
+	_frameReady = false;
+	SDL_UnlockMutex(_presentLock);
+
+	if (ready)
+	{
+		present(0, _frame.scaled.get(), _frame.palette, _frame.firstColor, _frame.numColors);
+	}
+}
+
 /**
  * Clears all the contents out of the internal buffer.
  */
 void Screen::clear()
 {
 	Surface::CleanSdlSurface(_surface.get());
-	Surface::CleanSdlSurface(_screen);
+	if (!_presentThread)
+	{
+		// with the present thread, the scaled frames cover the whole display
+		Surface::CleanSdlSurface(_screen);
+	}
 }
 
 /**
@@ -265,9 +465,13 @@ void Screen::setPalette(const SDL_Color* colors, int firstcolor, int ncolors, bo
 	SDL_SetColors(_surface.get(), const_cast<SDL_Color *>(colors), firstcolor, ncolors);
 
 	// defer actual update of screen until SDL_Flip()
-	if (immediately && _screen->format->BitsPerPixel == 8 && SDL_SetColors(_screen, const_cast<SDL_Color *>(colors), firstcolor, ncolors) == 0)
+	if (immediately && _screen->format->BitsPerPixel == 8)
 	{
-		Log(LOG_DEBUG) << "Display palette doesn't match requested palette";
+		finishPresent();
+		if (SDL_SetColors(_screen, const_cast<SDL_Color *>(colors), firstcolor, ncolors) == 0)
+		{
+			Log(LOG_DEBUG) << "Display palette doesn't match requested palette";
+		}
 	}
 
 	// Sanity check
@@ -322,6 +526,8 @@ int Screen::getHeight() const
  */
 void Screen::resetDisplay(bool resetVideo, bool noShaders)
 {
+	stopPresentThread();
+
 	int width = Options::displayWidth;
 	int height = Options::displayHeight;
 #ifdef __linux__
@@ -492,6 +698,7 @@ void Screen::resetDisplay(bool resetVideo, bool noShaders)
 	{
 		setPalette(getPalette());
 	}
+	startPresentThread();
 }
 
 /**
@@ -534,8 +741,10 @@ int Screen::getCursorLeftBlackBand() const
  * Saves a screenshot of the screen's contents.
  * @param filename Filename of the PNG file.
  */
-void Screen::screenshot(const std::string &filename) const
+void Screen::screenshot(const std::string &filename)
 {
+	finishPresent();
+
 	SDL_Surface *screenshot = SDL_AllocSurface(0, getWidth() - getWidth()%4, getHeight(), 24, 0xff, 0xff00, 0xff0000, 0);
 
 	if (useOpenGL())
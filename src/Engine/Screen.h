@@ -39,6 +39,15 @@ class Action;
 class Screen
 {
 private:
+	/// A finished frame handed to the present thread for scaling.
+	struct Frame
+	{
+		Surface::UniqueBufferPtr buffer;
+		Surface::UniqueSurfacePtr surface, scaled;
+		SDL_Color palette[256];
+		int firstColor, numColors;
+	};
+
 	SDL_Surface *_screen;
 	int _bpp;
 	int _baseWidth, _baseHeight;
@@ -52,8 +61,25 @@ private:
 	OpenGL glOutput;
 	Surface::UniqueBufferPtr _buffer;
 	Surface::UniqueSurfacePtr _surface;
+	Frame _frame;
+	bool _frameQueued, _frameReady, _presentStop;
+	SDL_Thread *_presentThread;
+	SDL_mutex *_presentLock;
+	SDL_cond *_presentCond;
 	/// Sets the _flags and _bpp variables based on game options; needed in more than one place now
 	void makeVideoFlags();
+	/// Scales a frame onto the display and flips it.
+	void present(SDL_Surface *frame, SDL_Surface *scaled, const SDL_Color *palette, int firstColor, int numColors);
+	/// Scales a frame to the display size.
+	void scaleFrame(SDL_Surface *frame, SDL_Surface *target);
+	/// Starts the present thread, if enabled.
+	void startPresentThread();
+	/// Stops the present thread.
+	void stopPresentThread();
+	/// Shows the frame scaled by the present thread.
+	void finishPresent();
+	/// Entry point of the present thread.
+	static int presentLoop(void *data);
 public:
 	static const int ORIGINAL_WIDTH;
 	static const int ORIGINAL_HEIGHT;
@@ -93,7 +119,7 @@ public:
 	/// Gets the screen's left black forbidden to cursor band's width.
 	int getCursorLeftBlackBand() const;
 	/// Takes a screenshot.
-	void screenshot(const std::string &filename) const;
+	void screenshot(const std::string &filename);
 	/// Checks whether a 32bit scaler is requested and works for the selected resolution
 	static bool use32bitScaler();
 	/// Checks whether OpenGL output is requested
@@ -2984,6 +2984,7 @@ void ScriptParserBase::parseNode(ScriptContainerBase& container, const std::stri
 	if (!container && !getDefault().empty())
 	{
 		parseBase(container, parentName, getDefault());
+		container._default = true;
 	}
 }
 
@@ -2999,6 +3000,7 @@ void ScriptParserBase::parseCode(ScriptContainerBase& container, const std::stri
 	if (!container && !getDefault().empty())
 	{
 		parseBase(container, parentName, getDefault());
+		container._default = true;
 	}
 }
 
@@ -373,7 +373,9 @@ struct TypeInfo
 class ScriptContainerBase
 {
 	friend struct ParserWriter;
+	friend class ScriptParserBase;
 	std::vector<Uint8> _proc;
+	bool _default = false;
 
 public:
 	/// Constructor.
@@ -402,6 +404,11 @@ public:
 	{
 		return *this ? _proc.data() : nullptr;
 	}
+	/// Test if it is the default script of the parser, not one given by a mod.
+	bool isDefault() const
+	{
+		return _default;
+	}
 };
 
 /**
@@ -444,6 +451,11 @@ public:
 	{
 		return _current.data();
 	}
+	/// Test if it is the default script of the parser, not one given by a mod.
+	bool isDefault() const
+	{
+		return _current.isDefault();
+	}
 	/// Get pointer to proc data.
 	const ScriptContainerBase* dataEvents() const
 	{
@@ -17,10 +17,13 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "Sound.h"
+#include <list>
+#include <map>
 #include "Options.h"
 #include "Logger.h"
 #include "Unicode.h"
 #include "FileMap.h"
+#include "SDL2Helpers.h"
 
 namespace OpenXcom
 {
@@ -38,12 +41,189 @@ Sound::UniqueSoundPtr Sound::NewSound(Mix_Chunk* sound)
 	return Sound::UniqueSoundPtr(sound);
 }
 
+namespace
+{
+
+/**
+ * Sound decoded on demand, kept until the decoded sounds
+ * take up more memory than allowed.
+ */
+struct DecodedSound
+{
+	const Sound *sound;
+	Sound::UniqueSoundPtr chunk;
+	/// Time the sound was last played until.
+	Uint32 playingUntil;
+};
+
+/// Decoded sounds, most recently played first.
+std::list<DecodedSound> decodedSounds;
+std::map<const Sound*, std::list<DecodedSound>::iterator> decodedIndex;
+size_t decodedBytes = 0;
+/// Sound playing on the ambience channel.
+const Sound *loopingSound = 0;
+
+/**
+ * Frees the decoded copy of a sound.
+ * @param sound Pointer to the sound.
+ */
+void dropDecoded(const Sound *sound)
+{
+	auto i = decodedIndex.find(sound);
+	if (i != decodedIndex.end())
+	{
+		decodedBytes -= i->second->chunk->alen;
+		decodedSounds.erase(i->second);
+		decodedIndex.erase(i);
+	}
+}
+
+/**
+ * Frees the least recently played sounds until the decoded
+ * sounds fit in the budget, skipping the ones still playing.
+ * @param keep Sound that was just decoded.
+ */
+void trimDecoded(const Sound *keep)
+{
+	size_t budget = (size_t)Options::oxceSoundCacheSize * 1024 * 1024;
+	Uint32 now = SDL_GetTicks();
+	auto i = decodedSounds.end();
+	while (decodedBytes > budget && i != decodedSounds.begin())
+	{
+		--i;
+		if (i->sound == keep || i->sound == loopingSound || (Sint32)(i->playingUntil - now) > 0)
+		{
+			continue;
+		}
+		decodedBytes -= i->chunk->alen;
+		decodedIndex.erase(i->sound);
+		i = decodedSounds.erase(i);
+	}
+}
+
+/**
+ * Gets how long a sound plays in the current mixer format.
+ * @param chunk Pointer to the decoded sound.
+ * @return Length in milliseconds.
+ */
+Uint32 getLength(const Mix_Chunk *chunk)
+{
+	int frequency, channels;
+	Uint16 format;
+	if (Mix_QuerySpec(&frequency, &format, &channels) == 0)
+	{
+		return 0;
+	}
+	Uint32 bytesPerSecond = frequency * channels * ((format & 0xFF) / 8);
+	return (Uint32)((Uint64)chunk->alen * 1000 / bytesPerSecond) + 1;
+}
+
+}
+
+/**
+ * Frees the decoded copy of the sound.
+ */
+Sound::~Sound()
+{
+	dropDecoded(this);
+}
+
+/**
+ * Moves a sound, the decoded copy of it is dropped.
+ * @param other Sound to move.
+ */
+Sound::Sound(Sound&& other) : _sound(std::move(other._sound)), _data(std::move(other._data)), _source(std::move(other._source)), _decodeFailed(other._decodeFailed)
+{
+	dropDecoded(&other);
+}
+
+/**
+ * Replaces a sound, the decoded copies of both are dropped.
+ * @param other Sound to move.
+ * @return This sound.
+ */
+Sound& Sound::operator=(Sound&& other)
+{
+	dropDecoded(this);
+	dropDecoded(&other);
+	_sound = std::move(other._sound);
+	_data = std::move(other._data);
+	_source = std::move(other._source);
+	_decodeFailed = other._decodeFailed;
+	return *this;
+}
+
+/**
+ * Gets the sound data ready for the mixer. Sounds only decoded
+ * when played are kept in a cache of the most recently played ones.
+ * @return Pointer to the decoded sound, or null if there's none.
+ */
+Mix_Chunk *Sound::getChunk() const
+{
+	if (_sound || _data.empty() || _decodeFailed)
+	{
+		return _sound.get();
+	}
+	auto i = decodedIndex.find(this);
+	if (i != decodedIndex.end())
+	{
+		decodedSounds.splice(decodedSounds.begin(), decodedSounds, i->second);
+	}
+	else
+	{
+		auto chunk = NewSound(Mix_LoadWAV_RW(SDL_RWFromConstMem(_data.data(), _data.size()), SDL_TRUE));
+		if (!chunk)
+		{
+			Log(LOG_ERROR) << "Sound::play(" << _source << "): mix error=" << Mix_GetError();
+			_decodeFailed = true;
+			return 0;
+		}
+		decodedBytes += chunk->alen;
+		decodedSounds.push_front(DecodedSound{ this, std::move(chunk), 0 });
+		decodedIndex[this] = decodedSounds.begin();
+		trimDecoded(this);
+	}
+	DecodedSound &decoded = decodedSounds.front();
+	decoded.playingUntil = SDL_GetTicks() + getLength(decoded.chunk.get());
+	return decoded.chunk.get();
+}
+
+/**
+ * Keeps the source file of a sound to decode it when it's played.
+ * @param rw SDL_RWops of the sound data.
+ * @return False if there was nothing to read.
+ */
+bool Sound::loadData(SDL_RWops *rw)
+{
+	dropDecoded(this);
+	_data.clear();
+	_decodeFailed = false;
+	_sound.reset();
+	size_t size = 0;
+	Uint8 *data = (Uint8 *)SDL_LoadFile_RW(rw, &size, SDL_TRUE);
+	if (data)
+	{
+		_data.assign(data, data + size);
+		SDL_free(data);
+	}
+	return !_data.empty();
+}
+
 /**
  * Loads a sound file from a specified filename.
  * @param filename Filename of the sound file.
  */
 void Sound::load(const std::string &filename) {
 	auto rw = FileMap::getRWops(filename);
+	if (Options::oxceSoundCacheSize > 0)
+	{
+		if (!loadData(rw))
+		{
+			Log(LOG_ERROR) << "Sound::load(" << filename << "): could not read file: " << SDL_GetError();
+		}
+		_source = filename;
+		return;
+	}
 	auto s = NewSound(Mix_LoadWAV_RW(rw, SDL_TRUE));
 	if (!s)
 	{
@@ -51,14 +231,28 @@ void Sound::load(const std::string &filename) {
 	}
 
 	//always overwrite
+	dropDecoded(this);
+	_data.clear();
 	_sound = std::move(s);
 }
 
 /**
- * Loads a sound file from a specified rwops.
+ * Loads a sound file from a specified rwops. With a sound cache budget,
+ * the file is only kept as is and decoded when it's played.
  * @param rw SDL_RWops of the sound data.
  */
 void Sound::load(SDL_RWops *rw) {
+	if (Options::oxceSoundCacheSize > 0)
+	{
+		if (!loadData(rw))
+		{
+			Log(LOG_ERROR) << "Sound::load(data): could not read data: " << SDL_GetError();
+		}
+		_source = "data";
+		return;
+	}
+	dropDecoded(this);
+	_data.clear();
 	auto s = NewSound(Mix_LoadWAV_RW(rw, SDL_TRUE));
 	if (!s)
 	{
@@ -75,9 +269,10 @@ void Sound::load(SDL_RWops *rw) {
  */
 void Sound::play(int channel, int angle, int distance) const
  {
-	if (!Options::mute && _sound)
+	Mix_Chunk *chunk = Options::mute ? 0 : getChunk();
+	if (chunk)
  	{
-		int chan = Mix_PlayChannel(channel, _sound.get(), 0);
+		int chan = Mix_PlayChannel(channel, chunk, 0);
 		if (chan == -1)
 		{
 			Log(LOG_WARNING) << Mix_GetError();
@@ -108,9 +303,15 @@ void Sound::stop()
  */
 void Sound::loop()
 {
-	if (!Options::mute && _sound && Mix_Playing(3) == 0)
+	if (!Options::mute && Mix_Playing(3) == 0)
 	{
-		int chan = Mix_PlayChannel(3, _sound.get(), -1);
+		Mix_Chunk *chunk = getChunk();
+		if (!chunk)
+		{
+			return;
+		}
+		loopingSound = this;
+		int chan = Mix_PlayChannel(3, chunk, -1);
 		if (chan == -1)
 		{
 			Log(LOG_WARNING) << Mix_GetError();
@@ -126,6 +327,7 @@ void Sound::stopLoop()
 	if (!Options::mute)
 	{
 		Mix_HaltChannel(3);
+		loopingSound = 0;
 	}
 }
 
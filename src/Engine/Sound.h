@@ -21,6 +21,7 @@
 #include <SDL_mixer.h>
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace OpenXcom
 {
@@ -44,16 +45,26 @@ public:
 
 private:
 	UniqueSoundPtr _sound;
+	/// Source file of a sound only decoded when played.
+	std::vector<Uint8> _data;
+	/// Name of the source file for error messages, "data" if it wasn't loaded from a file.
+	std::string _source;
+	/// Whether decoding the source file failed, so it's not tried again.
+	mutable bool _decodeFailed = false;
 
+	/// Gets the decoded sound, decoding it if needed.
+	Mix_Chunk *getChunk() const;
+	/// Keeps the source file to decode it when played.
+	bool loadData(SDL_RWops *rw);
 public:
 	/// Creates a blank sound effect.
 	Sound() = default;
 	/// Cleans up the sound effect.
-	~Sound() = default;
+	~Sound();
 	/// Move sound to another place.
-	Sound(Sound&& other) = default;
+	Sound(Sound&& other);
 	/// Move assignment
-	Sound& operator=(Sound&& other) = default;
+	Sound& operator=(Sound&& other);
 
 	/// Loads sound from the specified file.
 	void load(const std::string &filename);
@@ -21,6 +21,7 @@
 #include "Sound.h"
 #include "Logger.h"
 #include "SDL2Helpers.h"
+#include <algorithm>
 #include <climits>
 #include <cassert>
 
@@ -240,7 +241,11 @@ void SoundSet::loadCatByIndex(CatFile &catFile, int index, bool tftd)
 	} else { // nothing to do.
 		SDL_RWwrite(dest_rwops, sound, size, 1);
 	}
-	SDL_RWseek(dest_rwops, 0, RW_SEEK_SET);
+	// sounds decoded on demand keep the whole stream, so cut it to the WAV size
+	SDL_RWseek(dest_rwops, 4, RW_SEEK_SET);
+	size_t wav_size = std::min<size_t>(SDL_ReadLE32(dest_rwops) + 8, dest_size);
+	SDL_RWclose(dest_rwops);
+	dest_rwops = SDL_RWFromMem(dest_mem, wav_size);
 	_sounds[set_index].load(dest_rwops);  // this frees the dest_rwops
 	SDL_free(dest_mem);
 	SDL_free(sound);
@@ -20,6 +20,7 @@
 #include "ShaderDraw.h"
 #include "ShaderMove.h"
 #include <vector>
+#include <map>
 #include <algorithm>
 #include <SDL_gfxPrimitives.h>
 #include <SDL_image.h>
@@ -29,6 +30,7 @@
 #include "Logger.h"
 #include "SDL2Helpers.h"
 #include "FileMap.h"
+#include "Parallel.h"
 #ifdef _WIN32
 #include <malloc.h>
 #endif
@@ -101,6 +103,92 @@ inline void FixTransparent(const Surface::UniqueSurfacePtr& dest, int currentTra
 	}
 }
 
+/**
+ * Blits a sprite using its runs of opaque pixels,
+ * so transparent pixels are never looked at.
+ * @param dest Destination surface.
+ * @param range Part of the destination to draw on.
+ * @param src Sprite with runs of opaque pixels, see Surface::buildSpans.
+ * @param srcRange Part of the sprite to draw.
+ * @param x X offset of the sprite.
+ * @param y Y offset of the sprite.
+ * @param func Function drawing a single pixel.
+ */
+template<typename Func>
+void BlitSpans(SurfaceRaw<Uint8> dest, GraphSubset range, SurfaceRaw<const Uint8> src, GraphSubset srcRange, int x, int y, Func func)
+{
+	const GraphSubset area = GraphSubset::intersection(GraphSubset::intersection(range, GraphSubset(dest.getWidth(), dest.getHeight())), srcRange.offset(x, y));
+	if (!area)
+	{
+		return;
+	}
+	const std::vector<Uint16> &spans = *src.getSpans();
+	size_t i = 0;
+	for (int row = 0; row < src.getHeight() && row + y < area.end_y; ++row)
+	{
+		const int runs = spans[i++];
+		if (row + y >= area.beg_y)
+		{
+			const Uint8 *srcRow = src.getBuffer() + row * src.getPitch();
+			Uint8 *destRow = dest.getBuffer() + (row + y) * dest.getPitch();
+			for (int r = 0; r < runs; ++r)
+			{
+				const int begin = std::max<int>(spans[i + r * 2], area.beg_x - x);
+				const int end = std::min<int>(spans[i + r * 2] + spans[i + r * 2 + 1], area.end_x - x);
+				for (int px = begin; px < end; ++px)
+				{
+					func(destRow[px + x], srcRow[px]);
+				}
+			}
+		}
+		i += runs * 2;
+	}
+}
+
+/**
+ * PNG image decoded by lodepng, without any conversion.
+ */
+struct DecodedPng
+{
+	/// Whether the file was big enough to be decoded at all.
+	bool attempted = false;
+	unsigned error = 0;
+	std::vector<unsigned char> image;
+	unsigned width = 0, height = 0;
+	unsigned bpp = 0;
+	/// Palette colors, four bytes per color.
+	std::vector<unsigned char> palette;
+};
+
+/// Images decoded ahead of loading them, by file name.
+std::map<std::string, DecodedPng> preloadedPngs;
+
+/**
+ * Decodes a PNG file in memory.
+ * Touches nothing else, so it's safe to call from any thread.
+ * @param data File contents.
+ * @param size File size.
+ * @return Decoded image.
+ */
+DecodedPng DecodePng(const void *data, size_t size)
+{
+	DecodedPng decoded;
+	if ((data != NULL) && (size > 8 + 12 + 12)) // minimal PNG file size: header and two empty chunks
+	{
+		decoded.attempted = true;
+		lodepng::State state;
+		state.decoder.color_convert = 0;
+		decoded.error = lodepng::decode(decoded.image, decoded.width, decoded.height, state, (const unsigned char*)data, size);
+		if (!decoded.error)
+		{
+			LodePNGColorMode *color = &state.info_png.color;
+			decoded.bpp = lodepng_get_bpp(color);
+			decoded.palette.assign(color->palette, color->palette + color->palettesize * 4);
+		}
+	}
+	return decoded;
+}
+
 } //namespace
 
 /**
@@ -203,7 +291,7 @@ void Surface::CleanSdlSurface(SDL_Surface* surface)
  */
 void Surface::UniqueBufferDeleter::operator ()(Uint8* buffer)
 {
-	if (buffer)
+	if (buffer && owned)
 	{
 #ifdef _WIN32
 		_aligned_free(buffer);
@@ -253,6 +341,23 @@ Surface::Surface(int width, int height, int x, int y) : _x(x), _y(y), _visible(t
 	SDL_SetColorKey(_surface.get(), SDL_SRCCOLORKEY, 0);
 }
 
+/**
+ * Sets up a blank 8bpp surface over pixels owned by someone else,
+ * like a frame packed together with the rest of its set.
+ * @param pixels Pointer to aligned memory for the pixels, with the pitch of an aligned buffer.
+ * @param width Width in pixels.
+ * @param height Height in pixels.
+ */
+Surface::Surface(Uint8 *pixels, int width, int height) : _x{ }, _y{ }, _visible(true), _hidden(false), _redraw(false)
+{
+	_alignedBuffer = UniqueBufferPtr(pixels, UniqueBufferDeleter(false));
+	_surface = NewSdlSurface(_alignedBuffer, 8, width, height);
+	_width = _surface->w;
+	_height = _surface->h;
+	_pitch = _surface->pitch;
+	SDL_SetColorKey(_surface.get(), SDL_SRCCOLORKEY, 0);
+}
+
 /**
  * Performs a deep copy of an existing surface.
  * @param other Surface to copy from.
@@ -358,75 +463,85 @@ void Surface::loadScr(const std::string& filename)
  */
 void Surface::loadImage(const std::string &filename)
 {
+	_spans.clear();
 	// Destroy current surface (will be replaced)
 	_alignedBuffer = nullptr;
 	_surface = nullptr;
 
 	Log(LOG_VERBOSE) << "Loading image: " << filename;
-	auto rw = FileMap::getRWops(filename);
-	if (!rw) { return; } // relevant message gets logged in FileMap.
+	// images decoded ahead of time only need the file again if lodepng can't handle them
+	auto preloaded = preloadedPngs.find(filename);
+	SDL_RWops *rw = 0;
+	if (preloaded == preloadedPngs.end())
+	{
+		rw = FileMap::getRWops(filename);
+		if (!rw) { return; } // relevant message gets logged in FileMap.
+	}
 
 	// Try loading with LodePNG first
 	if (CrossPlatform::compareExt(filename, "png"))
 	{
-		size_t size;
-		void *data = SDL_LoadFile_RW(rw, &size, SDL_FALSE);
-		if ((data != NULL) && (size > 8 + 12 + 12)) // minimal PNG file size: header and two empty chunks
+		DecodedPng png;
+		if (preloaded != preloadedPngs.end())
+		{
+			png = std::move(preloaded->second);
+			preloadedPngs.erase(preloaded);
+		}
+		else
+		{
+			size_t size;
+			void *data = SDL_LoadFile_RW(rw, &size, SDL_FALSE);
+			png = DecodePng(data, size);
+			if (data) { SDL_free(data); }
+		}
+		if (png.attempted && !png.error)
 		{
-			std::vector<unsigned char> png;
-			png.resize(size);
-			memcpy(&png[0], data, size);
-
-			std::vector<unsigned char> image;
-			unsigned width, height;
-			lodepng::State state;
-			state.decoder.color_convert = 0;
-			unsigned error = lodepng::decode(image, width, height, state, png);
-			if (!error)
+			if (png.bpp == 8)
 			{
-				LodePNGColorMode *color = &state.info_png.color;
-				unsigned bpp = lodepng_get_bpp(color);
-				if (bpp == 8)
-				{
-					*this = Surface(width, height, 0, 0);
-					setPalette((SDL_Color*)color->palette, 0, color->palettesize);
-
-					ShaderDrawFunc(
-						[](Uint8& dest, unsigned char& src)
-						{
-							dest = src;
-						},
-						ShaderSurface(this),
-						ShaderSurface(SurfaceRaw<unsigned char>(image, width, height))
-					);
-					int transparent = 0;
-					for (int c = 0; c < _surface->format->palette->ncolors; ++c)
+				*this = Surface(png.width, png.height, 0, 0);
+				setPalette((SDL_Color*)png.palette.data(), 0, png.palette.size() / 4);
+
+				ShaderDrawFunc(
+					[](Uint8& dest, unsigned char& src)
 					{
-						SDL_Color *palColor = _surface->format->palette->colors + c;
-						if (palColor->unused == 0)
-						{
-							transparent = c;
-							break;
-						}
-					}
-					FixTransparent(_surface, transparent);
-					if (transparent != 0)
+						dest = src;
+					},
+					ShaderSurface(this),
+					ShaderSurface(SurfaceRaw<unsigned char>(png.image, png.width, png.height))
+				);
+				int transparent = 0;
+				for (int c = 0; c < _surface->format->palette->ncolors; ++c)
+				{
+					SDL_Color *palColor = _surface->format->palette->colors + c;
+					if (palColor->unused == 0)
 					{
-						Log(LOG_WARNING) << "Image " << filename << " (from lodepng) has incorrect transparent color index " << transparent << " (instead of 0).";
+						transparent = c;
+						break;
 					}
 				}
-			} else {
-				Log(LOG_ERROR) << "Image " << filename << " lodepng failed:" << lodepng_error_text(error);
+				FixTransparent(_surface, transparent);
+				if (transparent != 0)
+				{
+					Log(LOG_WARNING) << "Image " << filename << " (from lodepng) has incorrect transparent color index " << transparent << " (instead of 0).";
+				}
 			}
 		}
-		if (data) { SDL_free(data); }
+		else if (png.attempted)
+		{
+			Log(LOG_ERROR) << "Image " << filename << " lodepng failed:" << lodepng_error_text(png.error);
+		}
 	}
 	if (_surface)
 	{
-		SDL_RWclose(rw);
+		if (rw) { SDL_RWclose(rw); }
 	}
 	else // Otherwise default to SDL_Image
 	{
+		if (!rw)
+		{
+			rw = FileMap::getRWops(filename);
+			if (!rw) { return; }
+		}
 		SDL_RWseek(rw, RW_SEEK_SET, 0); // rewind in case .png was no PNG at all
 		auto surface = NewSdlSurface(IMG_Load_RW(rw, SDL_TRUE));
 		if (!surface)
@@ -451,6 +566,61 @@ void Surface::loadImage(const std::string &filename)
 	}
 }
 
+/**
+ * Decodes PNG images ahead of loading them with loadImage(), spread
+ * over several threads, replacing any images decoded before.
+ * Files are read here one by one, only the decoding runs in parallel,
+ * and any errors are logged once the image is actually loaded,
+ * so nothing changes in the load order.
+ * @param filenames Names of the image files, other formats are skipped.
+ */
+void Surface::preloadImages(const std::vector<std::string> &filenames)
+{
+	preloadedPngs.clear();
+	std::vector<std::string> names;
+	std::vector<std::vector<unsigned char> > files;
+	for (const auto& filename : filenames)
+	{
+		if (!CrossPlatform::compareExt(filename, "png") || !FileMap::fileExists(filename))
+		{
+			continue;
+		}
+		auto rw = FileMap::getRWops(filename);
+		if (!rw)
+		{
+			continue;
+		}
+		size_t size = 0;
+		unsigned char *data = (unsigned char *)SDL_LoadFile_RW(rw, &size, SDL_TRUE);
+		if (data)
+		{
+			names.push_back(filename);
+			files.push_back(std::vector<unsigned char>(data, data + size));
+			SDL_free(data);
+		}
+	}
+
+	std::vector<DecodedPng> decoded(files.size());
+	Parallel::forEach((int)files.size(), [&](int i)
+	{
+		decoded[i] = DecodePng(files[i].data(), files[i].size());
+		files[i].clear();
+		files[i].shrink_to_fit();
+	});
+	for (size_t i = 0; i < decoded.size(); ++i)
+	{
+		preloadedPngs[names[i]] = std::move(decoded[i]);
+	}
+}
+
+/**
+ * Drops the decoded images that were never loaded.
+ */
+void Surface::clearPreloadedImages()
+{
+	preloadedPngs.clear();
+}
+
 /**
  * Loads the contents of an X-Com SPK image file into
  * the surface. SPK files are compressed with a custom
@@ -536,6 +706,7 @@ void Surface::loadBdy(const std::string &filename)
  */
 void Surface::clear()
 {
+	_spans.clear();
 	CleanSdlSurface(_surface.get());
 }
 
@@ -758,6 +929,7 @@ void Surface::copy(Surface *surface)
  */
 void Surface::drawRect(SDL_Rect *rect, Uint8 color)
 {
+	_spans.clear();
 	SDL_FillRect(_surface.get(), rect, color);
 }
 
@@ -771,6 +943,7 @@ void Surface::drawRect(SDL_Rect *rect, Uint8 color)
  */
 void Surface::drawRect(Sint16 x, Sint16 y, Sint16 w, Sint16 h, Uint8 color)
 {
+	_spans.clear();
 	SDL_Rect rect;
 	rect.w = w;
 	rect.h = h;
@@ -789,6 +962,7 @@ void Surface::drawRect(Sint16 x, Sint16 y, Sint16 w, Sint16 h, Uint8 color)
  */
 void Surface::drawLine(Sint16 x1, Sint16 y1, Sint16 x2, Sint16 y2, Uint8 color)
 {
+	_spans.clear();
 	lineColor(_surface.get(), x1, y1, x2, y2, Palette::getRGBA(getPalette(), color));
 }
 
@@ -801,6 +975,7 @@ void Surface::drawLine(Sint16 x1, Sint16 y1, Sint16 x2, Sint16 y2, Uint8 color)
  */
 void Surface::drawCircle(Sint16 x, Sint16 y, Sint16 r, Uint8 color)
 {
+	_spans.clear();
 	filledCircleColor(_surface.get(), x, y, r, Palette::getRGBA(getPalette(), color));
 }
 
@@ -813,6 +988,7 @@ void Surface::drawCircle(Sint16 x, Sint16 y, Sint16 r, Uint8 color)
  */
 void Surface::drawPolygon(Sint16 *x, Sint16 *y, int n, Uint8 color)
 {
+	_spans.clear();
 	filledPolygonColor(_surface.get(), x, y, n, Palette::getRGBA(getPalette(), color));
 }
 
@@ -827,6 +1003,7 @@ void Surface::drawPolygon(Sint16 *x, Sint16 *y, int n, Uint8 color)
  */
 void Surface::drawTexturedPolygon(Sint16 *x, Sint16 *y, int n, Surface *texture, int dx, int dy)
 {
+	_spans.clear();
 	texturedPolygon(_surface.get(), x, y, n, texture->getSurface(), dx, dy);
 }
 
@@ -839,6 +1016,7 @@ void Surface::drawTexturedPolygon(Sint16 *x, Sint16 *y, int n, Surface *texture,
  */
 void Surface::drawString(Sint16 x, Sint16 y, const char *s, Uint8 color)
 {
+	_spans.clear();
 	stringColor(_surface.get(), x, y, s, Palette::getRGBA(getPalette(), color));
 }
 
@@ -920,6 +1098,7 @@ void Surface::setHidden(bool hidden)
  */
 void Surface::lock()
 {
+	_spans.clear();
 	SDL_LockSurface(_surface.get());
 }
 
@@ -938,6 +1117,25 @@ void Surface::unlock()
  */
 void Surface::blitRaw(SurfaceRaw<Uint8> destSurf, SurfaceRaw<const Uint8> srcSurf, int x, int y, int shade, bool half, int newBaseColor)
 {
+	if (srcSurf.getSpans())
+	{
+		GraphSubset srcRange(srcSurf.getWidth(), srcSurf.getHeight());
+		if (half)
+		{
+			srcRange.beg_x = srcRange.end_x/2;
+		}
+		GraphSubset destRange(destSurf.getWidth(), destSurf.getHeight());
+		if (newBaseColor)
+		{
+			const int color = (newBaseColor - 1) << 4;
+			BlitSpans(destSurf, destRange, srcSurf, srcRange, x, y, [&](Uint8 &dest, const Uint8 &src) { helper::ColorReplace::func(dest, src, shade, color); });
+		}
+		else
+		{
+			BlitSpans(destSurf, destRange, srcSurf, srcRange, x, y, [&](Uint8 &dest, const Uint8 &src) { helper::StandardShade::func(dest, src, shade); });
+		}
+		return;
+	}
 	ShaderMove<const Uint8> src(srcSurf, x, y);
 	if (half)
 	{
@@ -983,6 +1181,11 @@ void Surface::blitNShade(SurfaceRaw<Uint8> surface, int x, int y, int shade, boo
  */
 void Surface::blitNShade(SurfaceRaw<Uint8> surface, int x, int y, int shade, GraphSubset range) const
 {
+	if (!_spans.empty())
+	{
+		BlitSpans(surface, range, SurfaceRaw<const Uint8>(this), GraphSubset(getWidth(), getHeight()), x, y, [&](Uint8 &dest, const Uint8 &src) { helper::StandardShade::func(dest, src, shade); });
+		return;
+	}
 	ShaderMove<const Uint8> src(this, x, y);
 	ShaderMove<Uint8> dest(surface);
 
@@ -991,6 +1194,57 @@ void Surface::blitNShade(SurfaceRaw<Uint8> surface, int x, int y, int shade, Gra
 	ShaderDraw<helper::StandardShade>(dest, src, ShaderScalar(shade));
 }
 
+/**
+ * Finds the runs of opaque pixels in each row of the surface,
+ * so shaded blits can skip over transparent pixels instead of
+ * checking them one by one. Only worth it for mostly transparent
+ * sprites, others keep blitting every pixel.
+ * Any change to the pixels drops the runs again.
+ */
+void Surface::buildSpans()
+{
+	_spans.clear();
+	if (!_alignedBuffer)
+	{
+		return;
+	}
+	const Uint8 *pixels = _alignedBuffer.get();
+	int opaque = 0;
+	for (int y = 0; y < getHeight(); ++y)
+	{
+		opaque += (int)std::count_if(pixels + y * getPitch(), pixels + y * getPitch() + getWidth(), [](Uint8 p) { return p != 0; });
+	}
+	if (opaque * 2 > getWidth() * getHeight())
+	{
+		return;
+	}
+
+	std::vector<Uint16> spans;
+	for (int y = 0; y < getHeight(); ++y)
+	{
+		const Uint8 *row = pixels + y * getPitch();
+		const size_t count = spans.size();
+		spans.push_back(0);
+		for (int x = 0; x < getWidth();)
+		{
+			if (row[x] == 0)
+			{
+				++x;
+				continue;
+			}
+			int begin = x;
+			while (x < getWidth() && row[x] != 0)
+			{
+				++x;
+			}
+			spans.push_back(begin);
+			spans.push_back(x - begin);
+			++spans[count];
+		}
+	}
+	_spans = std::move(spans);
+}
+
 /**
  * Set the surface to be redrawn.
  * @param valid true means redraw.
@@ -1009,6 +1263,7 @@ void Surface::invalidate(bool valid)
  */
 void Surface::resize(int width, int height)
 {
+	_spans.clear();
 	// Set up new surface
 	Uint8 bpp = _surface->format->BitsPerPixel;
 	auto alignedBuffer = NewAlignedBuffer(bpp, width, height);
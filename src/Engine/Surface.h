@@ -46,6 +46,10 @@ class Surface
 public:
 	struct UniqueBufferDeleter
 	{
+		/// Whether the buffer belongs to the surface or is part of a bigger one.
+		bool owned;
+		UniqueBufferDeleter() : owned(true) { }
+		explicit UniqueBufferDeleter(bool isOwned) : owned(isOwned) { }
 		void operator()(Uint8*);
 	};
 	struct UniqueSurfaceDeleter
@@ -89,6 +93,8 @@ protected:
 	Uint8 _visible: 1;
 	Uint8 _hidden: 1;
 	Uint8 _redraw: 1;
+	/// Runs of opaque pixels in each row, empty if blits check every pixel.
+	std::vector<Uint16> _spans;
 
 	/// Copies raw pixels.
 	template <typename T>
@@ -100,6 +106,8 @@ public:
 	Surface();
 	/// Creates a new surface with the specified size and position.
 	Surface(int width, int height, int x = 0, int y = 0);
+	/// Creates a new surface drawing into part of a shared buffer.
+	Surface(Uint8 *pixels, int width, int height);
 	/// Creates a new surface from an existing one.
 	Surface(const Surface& other);
 	/// Move surface to another place.
@@ -129,6 +137,10 @@ public:
 	void loadBdy(const std::string &filename);
 	/// Loads a general image file.
 	void loadImage(const std::string &filename);
+	/// Decodes image files ahead of loading them.
+	static void preloadImages(const std::vector<std::string> &filenames);
+	/// Drops the images decoded ahead that were never loaded.
+	static void clearPreloadedImages();
 	/// Clears the surface's contents with a specified colour.
 	void clear();
 	/// Offsets the surface's colors by a set amount.
@@ -262,6 +274,7 @@ public:
 	 */
 	Uint8 *getRaw(int x, int y)
 	{
+		_spans.clear();
 		return (Uint8 *)_surface->pixels + (y * _surface->pitch + x * _surface->format->BytesPerPixel);
 	}
 	/**
@@ -270,6 +283,7 @@ public:
 	 */
 	SDL_Surface *getSurface()
 	{
+		_spans.clear();
 		return _surface.get();
 	}
 	/**
@@ -300,6 +314,7 @@ public:
 	/// Get pointer to buffer
 	Uint8* getBuffer()
 	{
+		_spans.clear();
 		return _alignedBuffer.get();
 	}
 	/// Get pointer to buffer
@@ -319,6 +334,13 @@ public:
 	void blitNShade(SurfaceRaw<Uint8> surface, int x, int y, int shade = 0, bool half = false, int newBaseColor = 0) const;
 	/// Specific blit function to blit battlescape terrain data in different shades in a fast way.
 	void blitNShade(SurfaceRaw<Uint8> surface, int x, int y, int shade, GraphSubset range) const;
+	/// Finds the runs of opaque pixels so blits can skip the transparent ones.
+	void buildSpans();
+	/// Gets the runs of opaque pixels in each row.
+	const std::vector<Uint16>& getSpans() const
+	{
+		return _spans;
+	}
 	/// Invalidate the surface: force it to be redrawn
 	void invalidate(bool valid = true);
 
@@ -340,6 +362,7 @@ class SurfaceRaw
 {
 	Pixel* _buffer;
 	Uint16 _width, _height, _pitch;
+	const std::vector<Uint16>* _spans;
 
 public:
 	/// Default constructor
@@ -347,7 +370,8 @@ public:
 		_buffer{ nullptr },
 		_width{ 0 },
 		_height{ 0 },
-		_pitch{ 0 }
+		_pitch{ 0 },
+		_spans{ nullptr }
 	{
 
 	}
@@ -363,7 +387,8 @@ public:
 		_buffer{ buffer },
 		_width{ static_cast<Uint16>(width) },
 		_height{ static_cast<Uint16>(height) },
-		_pitch{ static_cast<Uint16>(pitch) }
+		_pitch{ static_cast<Uint16>(pitch) },
+		_spans{ nullptr }
 	{
 
 	}
@@ -372,7 +397,12 @@ public:
 	template<typename = std::enable_if<std::is_same<Uint8, Pixel>::value, void>>
 	SurfaceRaw(Surface* surf) : SurfaceRaw{ }
 	{
-		if (surf)
+		if constexpr (std::is_const<Pixel>::value)
+		{
+			// only reading, so the surface keeps its runs of opaque pixels
+			*this = SurfaceRaw{ static_cast<const Surface*>(surf) };
+		}
+		else if (surf)
 		{
 			*this = SurfaceRaw{ surf->getBuffer(), surf->getWidth(), surf->getHeight(), surf->getPitch() };
 		}
@@ -385,6 +415,7 @@ public:
 		if (surf)
 		{
 			*this = SurfaceRaw{ surf->getBuffer(), surf->getWidth(), surf->getHeight(), surf->getPitch() };
+			_spans = &surf->getSpans();
 		}
 	}
 
@@ -468,6 +499,12 @@ public:
 	{
 		return _buffer;
 	}
+
+	/// Get runs of opaque pixels of the source surface, if it has any.
+	const std::vector<Uint16>* getSpans() const
+	{
+		return _spans && !_spans->empty() ? _spans : nullptr;
+	}
 };
 
 /**
@@ -20,6 +20,7 @@
 #include <climits>
 #include "Surface.h"
 #include "FileMap.h"
+#include "Options.h"
 
 namespace OpenXcom
 {
@@ -29,17 +30,119 @@ namespace OpenXcom
  * @param width Frame width in pixels.
  * @param height Frame height in pixels.
  */
-SurfaceSet::SurfaceSet(int width, int height) : _width(width), _height(height), _sharedFrames(INT_MAX)
+SurfaceSet::SurfaceSet(int width, int height) : _atlas(0), _width(width), _height(height), _sharedFrames(INT_MAX)
 {
 
 }
 
+/**
+ * Performs a deep copy of an existing surface set.
+ * The copied frames each get their own pixels.
+ * @param other Surface set to copy from.
+ */
+SurfaceSet::SurfaceSet(const SurfaceSet& other) : _frames(other._frames), _atlas(0), _width(other._width), _height(other._height), _sharedFrames(other._sharedFrames)
+{
+
+}
+
+/**
+ * Moves an existing surface set, along with the pixels of its frames.
+ * @param other Surface set to move from.
+ */
+SurfaceSet::SurfaceSet(SurfaceSet&& other) : _frames(std::move(other._frames)), _atlas(other._atlas), _width(other._width), _height(other._height), _sharedFrames(other._sharedFrames)
+{
+	other._atlas = 0;
+}
+
 /**
  * Deletes the images from memory.
  */
 SurfaceSet::~SurfaceSet()
 {
+	_frames.clear();
+	freeAtlas();
+}
+
+/**
+ * Replaces the frames with a deep copy of another surface set.
+ * @param other Surface set to copy from.
+ * @return This surface set.
+ */
+SurfaceSet& SurfaceSet::operator=(const SurfaceSet& other)
+{
+	if (this != &other)
+	{
+		_frames = other._frames;
+		freeAtlas();
+		_width = other._width;
+		_height = other._height;
+		_sharedFrames = other._sharedFrames;
+	}
+	return *this;
+}
+
+/**
+ * Replaces the frames with the ones of another surface set.
+ * @param other Surface set to move from.
+ * @return This surface set.
+ */
+SurfaceSet& SurfaceSet::operator=(SurfaceSet&& other)
+{
+	if (this != &other)
+	{
+		_frames = std::move(other._frames);
+		freeAtlas();
+		_atlas = other._atlas;
+		other._atlas = 0;
+		_width = other._width;
+		_height = other._height;
+		_sharedFrames = other._sharedFrames;
+	}
+	return *this;
+}
+
+/**
+ * Replaces the frames with blank ones. With the sprite atlas on,
+ * the frames share a single buffer, so big sets don't make
+ * thousands of small allocations and their pixels stay close
+ * together in memory. Frames replaced later get their own buffers.
+ * @param nframes Number of frames.
+ */
+void SurfaceSet::createFrames(int nframes)
+{
+	_frames.clear();
+	freeAtlas();
+	_frames.reserve(nframes);
+	if (Options::oxceSpriteAtlas && nframes > 1)
+	{
+		_atlas = Surface::NewAlignedBuffer(8, _width, _height * nframes).release();
+		_frames.push_back(Surface(_atlas, _width, _height));
+		const int frameSize = _frames[0].getPitch() * _height;
+		for (int i = 1; i < nframes; ++i)
+		{
+			_frames.push_back(Surface(_atlas + i * frameSize, _width, _height));
+		}
+	}
+	else
+	{
+		for (int i = 0; i < nframes; ++i)
+		{
+			_frames.push_back(Surface(_width, _height));
+		}
+	}
+}
 
+/**
+ * Frees the buffer shared by the loaded frames,
+ * they must not be in use anymore.
+ */
+void SurfaceSet::freeAtlas()
+{
+	if (_atlas)
+	{
+		Surface::UniqueBufferDeleter()(_atlas);
+		_atlas = 0;
+	}
 }
 
 /**
@@ -78,16 +181,12 @@ void SurfaceSet::loadPck(const std::string &pck, const std::string &tab)
 		{
 			nframes = size / 4;
 		}
-		for (int frame = 0; frame < nframes; ++frame)
-		{
-			_frames.push_back(Surface(_width, _height));
-		}
 	}
 	else
 	{
 		nframes = 1;
-		_frames.push_back(Surface(_width, _height));
 	}
+	createFrames(nframes);
 
 	auto imgFile = FileMap::getIStream(pck);
 	Uint8 value;
@@ -148,11 +247,7 @@ void SurfaceSet::loadDat(const std::string &filename)
 
 	nframes = (int)size / (_width * _height);
 
-	_frames.resize(nframes);
-	for (int i = 0; i < nframes; ++i)
-	{
-		_frames[i] = Surface(_width, _height);
-	}
+	createFrames(nframes);
 
 	Uint8 value;
 	int x = 0, y = 0, frame = 0;
@@ -286,6 +381,18 @@ size_t SurfaceSet::getTotalFrames() const
 	return _frames.size();
 }
 
+/**
+ * Finds the runs of opaque pixels in all frames, for sets
+ * that won't change anymore and are blitted with shades.
+ */
+void SurfaceSet::buildSpans()
+{
+	for (auto& frame : _frames)
+	{
+		frame.buildSpans();
+	}
+}
+
 /**
  * Replaces a certain amount of colors in all of the frames.
  * @param colors Pointer to the set of colors.
@@ -37,22 +37,28 @@ class SurfaceSet
 {
 private:
 	std::vector<Surface> _frames;
+	/// Pixels of all the frames loaded together, one after another.
+	Uint8 *_atlas;
 	int _width, _height;
 	int _sharedFrames;
 
+	/// Creates blank frames for loading the set.
+	void createFrames(int nframes);
+	/// Frees the pixels of the loaded frames.
+	void freeAtlas();
 public:
 	/// Crates a surface set with frames of the specified size.
 	SurfaceSet(int width, int height);
 	/// Creates a surface set from an existing one.
-	SurfaceSet(const SurfaceSet& other) = default;
+	SurfaceSet(const SurfaceSet& other);
 	/// Creates a surface set from an existing one.
-	SurfaceSet(SurfaceSet&& other) = default;
+	SurfaceSet(SurfaceSet&& other);
 	/// Cleans up the surface set.
 	~SurfaceSet();
 	/// Assignment operator.
-	SurfaceSet& operator=(const SurfaceSet& other) = default;
+	SurfaceSet& operator=(const SurfaceSet& other);
 	/// Assignment operator.
-	SurfaceSet& operator=(SurfaceSet&& other) = default;
+	SurfaceSet& operator=(SurfaceSet&& other);
 
 	/// Loads an X-Com set of PCK/TAB image files.
 	void loadPck(const std::string &pck, const std::string &tab = "");
@@ -76,6 +82,8 @@ public:
 
 	/// Gets the total frames in the set.
 	size_t getTotalFrames() const;
+	/// Finds the runs of opaque pixels in all frames.
+	void buildSpans();
 	/// Sets the surface set's palette.
 	void setPalette(const SDL_Color *colors, int firstcolor = 0, int ncolors = 256);
 };
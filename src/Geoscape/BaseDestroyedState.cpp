@@ -152,6 +152,21 @@ void BaseDestroyedState::btnOkClick(Action *)
 		return;
 	}
 
+	removeBase();
+}
+
+/**
+ * Removes the destroyed base from the game,
+ * together with everything in it.
+ * Bases that were only damaged are left alone.
+ */
+void BaseDestroyedState::removeBase()
+{
+	if (_partialDestruction)
+	{
+		return;
+	}
+
 	for (auto xbaseIt = _game->getSavedGame()->getBases()->begin(); xbaseIt != _game->getSavedGame()->getBases()->end(); ++xbaseIt)
 	{
 		Base* xbase = (*xbaseIt);
@@ -48,6 +48,8 @@ public:
 	~BaseDestroyedState();
 	/// Handler for clicking the Cydonia mission button.
 	void btnOkClick(Action *action);
+	/// Removes the base from the game, unless it was only damaged.
+	void removeBase();
 
 };
 
@@ -0,0 +1,314 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "CampaignSimulator.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <yaml-cpp/yaml.h>
+#include "BaseDestroyedState.h"
+#include "GeoscapeState.h"
+#include "MonthlyReportState.h"
+#include "../Engine/Exception.h"
+#include "../Engine/Game.h"
+#include "../Engine/Logger.h"
+#include "../Engine/Options.h"
+#include "../Engine/RNG.h"
+#include "../Savegame/Base.h"
+#include "../Savegame/Craft.h"
+#include "../Savegame/GameTime.h"
+#include "../Savegame/SavedGame.h"
+
+namespace OpenXcom
+{
+
+namespace
+{
+
+/// Number of 5 second steps in a day, the most the geoscape advances at once.
+const int SimulatorDaySteps = 12 * 60 * 24;
+
+/// Number of advances in a row without any progress after which the campaign is considered stuck.
+const int SimulatorStallLimit = 1000;
+
+}
+
+/**
+ * Sets up a simulation of a saved campaign.
+ * @param game Pointer to the core game, without any state.
+ * @param filename Save file name, relative to the user folder.
+ * @param months Number of months to play.
+ * @param seed Random seed to play with, empty to keep the one in the save.
+ * @param compare True to check that skipping quiet steps doesn't change the outcome.
+ */
+CampaignSimulator::CampaignSimulator(Game *game, const std::string &filename, int months, const std::string &seed, bool compare) : _game(game), _filename(filename), _months(months), _seed(seed), _compare(compare), _basesLost(0), _rating(0)
+{
+}
+
+/**
+ * Gets a monotonic timestamp.
+ * @return Time in nanoseconds.
+ */
+uint64_t CampaignSimulator::now()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * Does what the player would do with a popup: nothing but
+ * clicking it away, except for the ones that change the game
+ * when closed. Takes ownership of the popup.
+ * @param popup Pointer to the popup state.
+ */
+void CampaignSimulator::handlePopup(State *popup)
+{
+	if (BaseDestroyedState *destroyed = dynamic_cast<BaseDestroyedState*>(popup))
+	{
+		size_t bases = _game->getSavedGame()->getBases()->size();
+		destroyed->removeBase();
+		if (_game->getSavedGame()->getBases()->size() != bases)
+		{
+			++_basesLost;
+			Log(LOG_INFO) << "Base lost on " << _game->getSavedGame()->getTime()->getYear() << "-" << _game->getSavedGame()->getTime()->getMonth() << "-" << _game->getSavedGame()->getTime()->getDay();
+		}
+	}
+	else if (MonthlyReportState *monthly = dynamic_cast<MonthlyReportState*>(popup))
+	{
+		_rating = monthly->getRating();
+		if (monthly->isGameOver())
+		{
+			Log(LOG_INFO) << "The council has ended the campaign.";
+			_game->getSavedGame()->setEnding(END_LOSE);
+		}
+		else
+		{
+			// psi training and saving are left out, nobody is there to assign or load
+			monthly->awardMonthlyService();
+		}
+	}
+	delete popup;
+}
+
+/**
+ * Prints the state of the campaign to the log and the console.
+ * @param month Number of the month that ended.
+ * @param time Time spent simulating the month in nanoseconds.
+ */
+void CampaignSimulator::report(int month, uint64_t time)
+{
+	SavedGame *save = _game->getSavedGame();
+	std::ostringstream ss;
+	ss << "Month " << std::setw(3) << month << ": score " << std::setw(6) << _rating << ", funds " << std::setw(10) << save->getFunds();
+	ss << ", bases " << save->getBases()->size() << ", ufos " << save->getUfos()->size() << ", alien missions " << save->getAlienMissions().size();
+	ss << ", alien bases " << save->getAlienBases()->size() << ", " << std::fixed << std::setprecision(1) << time / 1e6 << " ms";
+	Log(LOG_INFO) << ss.str();
+	std::cout << ss.str() << std::endl;
+}
+
+/**
+ * Loads the save and plays the campaign for the requested
+ * number of months or until it ends.
+ * @param skipQuiet True to let the geoscape skip steps where nothing happens.
+ * @param summary Filled with the final state of the campaign, to compare runs.
+ * @return Process exit code.
+ */
+int CampaignSimulator::play(bool skipQuiet, std::string &summary)
+{
+	_basesLost = 0;
+	_rating = 0;
+
+	SavedGame *save = new SavedGame(_game->getMod());
+	try
+	{
+		save->load(_filename, _game->getMod(), _game->getLanguage());
+	}
+	catch (Exception &e)
+	{
+		Log(LOG_ERROR) << e.what();
+		delete save;
+		return EXIT_FAILURE;
+	}
+	catch (YAML::Exception &e)
+	{
+		Log(LOG_ERROR) << e.what();
+		delete save;
+		return EXIT_FAILURE;
+	}
+	_game->setSavedGame(save);
+
+	if (save->getSavedBattle() != 0)
+	{
+		Log(LOG_ERROR) << _filename << " is a battlescape save, the campaign can only be simulated from the geoscape.";
+		return EXIT_FAILURE;
+	}
+	if (save->getBases()->empty())
+	{
+		Log(LOG_ERROR) << _filename << " has no bases.";
+		return EXIT_FAILURE;
+	}
+	if (!_seed.empty())
+	{
+		RNG::setSeed(strtoull(_seed.c_str(), 0, 10));
+	}
+
+	// crafts stay at home, nobody is there to fly them
+	for (auto* base : *save->getBases())
+	{
+		for (auto* craft : *base->getCrafts())
+		{
+			if (craft->getStatusId() == CRAFT_OUT)
+			{
+				craft->returnToBase();
+			}
+		}
+	}
+
+	GeoscapeState *state = new GeoscapeState;
+	_game->pushState(state);
+	state->init();
+	state->setHeadless(true);
+	state->setSkipQuietSteps(skipQuiet);
+
+	const int firstMonth = save->getMonthsPassed();
+	int month = firstMonth;
+	int steps = 0, stalls = 0;
+	uint64_t start = now(), monthStart = start;
+	while (save->getMonthsPassed() < firstMonth + _months && save->getEnding() == END_NONE)
+	{
+		int taken = state->advanceTime(SimulatorDaySteps);
+		steps += taken;
+		state->abortDogfights();
+
+		bool popups = false;
+		while (State *popup = state->takePopup())
+		{
+			handlePopup(popup);
+			popups = true;
+		}
+
+		// nobody is there to watch the screens the geoscape shows by itself
+		while (!_game->isState(state))
+		{
+			_game->popState();
+		}
+
+		if (month != save->getMonthsPassed())
+		{
+			uint64_t time = now();
+			report(month, time - monthStart);
+			month = save->getMonthsPassed();
+			monthStart = time;
+		}
+
+		if (taken != 0 || popups)
+		{
+			stalls = 0;
+		}
+		else if (++stalls > SimulatorStallLimit)
+		{
+			Log(LOG_ERROR) << "The geoscape did not advance after " << SimulatorStallLimit << " tries, stopping.";
+			break;
+		}
+	}
+	uint64_t total = now() - start;
+
+	std::ostringstream ss;
+	ss << "Simulation of " << _filename << ": " << save->getMonthsPassed() - firstMonth << " months, " << steps << " steps (" << state->getSkippedSteps() << " skipped), " << _basesLost << " bases lost, ";
+	ss << std::fixed << std::setprecision(1) << total / 1e6 << " ms";
+	if (save->getEnding() == END_LOSE)
+	{
+		ss << ", campaign lost";
+	}
+	else if (save->getEnding() == END_WIN)
+	{
+		ss << ", campaign won";
+	}
+	Log(LOG_INFO) << ss.str();
+	std::cout << ss.str() << std::endl;
+
+	std::ostringstream end;
+	const GameTime *time = save->getTime();
+	end << time->getYear() << "-" << time->getMonth() << "-" << time->getDay() << " " << time->getHour() << ":" << time->getMinute() << ":" << time->getSecond();
+	end << ", score " << _rating << ", funds " << save->getFunds() << ", bases " << save->getBases()->size() << ", ufos " << save->getUfos()->size();
+	end << ", alien missions " << save->getAlienMissions().size() << ", alien bases " << save->getAlienBases()->size() << ", seed " << RNG::getSeed();
+	summary = end.str();
+
+	_game->popState();
+	return EXIT_SUCCESS;
+}
+
+/**
+ * Loads the game data, then plays the campaign. When comparing,
+ * the campaign is played twice, stepping through every 5 seconds
+ * and skipping the quiet ones, and both runs have to end the same.
+ * @return Process exit code.
+ */
+int CampaignSimulator::run()
+{
+	try
+	{
+		Log(LOG_INFO) << "Loading data...";
+		Options::updateMods();
+		_game->loadMods();
+		_game->loadLanguages();
+	}
+	catch (std::exception &e)
+	{
+		Log(LOG_ERROR) << e.what();
+		return EXIT_FAILURE;
+	}
+
+	// the seed in the save is the whole point of a reproducible run
+	Options::newSeedOnLoad = false;
+	Options::mute = true;
+
+	std::string skipped;
+	if (!_compare)
+	{
+		return play(true, skipped);
+	}
+
+	std::string stepped;
+	Log(LOG_INFO) << "Playing every step...";
+	int result = play(false, stepped);
+	if (result != EXIT_SUCCESS)
+	{
+		return result;
+	}
+	Log(LOG_INFO) << "Playing with quiet steps skipped...";
+	result = play(true, skipped);
+	if (result != EXIT_SUCCESS)
+	{
+		return result;
+	}
+	if (stepped != skipped)
+	{
+		Log(LOG_ERROR) << "Skipping quiet steps changed the campaign:";
+		Log(LOG_ERROR) << "stepped: " << stepped;
+		Log(LOG_ERROR) << "skipped: " << skipped;
+		std::cout << "Skipping quiet steps changed the campaign" << std::endl;
+		return EXIT_FAILURE;
+	}
+	Log(LOG_INFO) << "Both runs ended the same: " << skipped;
+	std::cout << "Both runs ended the same: " << skipped << std::endl;
+	return EXIT_SUCCESS;
+}
+
+}
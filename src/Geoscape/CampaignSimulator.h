@@ -0,0 +1,65 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <cstdint>
+
+namespace OpenXcom
+{
+
+class Game;
+class GeoscapeState;
+class State;
+
+/**
+ * Plays a saved campaign on the geoscape without video or player,
+ * for balance testing. The player side follows a fixed policy:
+ * every popup is accepted, crafts stay at home and base defenses
+ * are decided without a battle. Soldiers still earn their monthly
+ * service commendations. Score, funds and alien activity
+ * are reported at the end of every month.
+ * It can also play the campaign twice to check that skipping quiet
+ * geoscape steps doesn't change how it plays out.
+ */
+class CampaignSimulator
+{
+private:
+	Game *_game;
+	std::string _filename;
+	int _months;
+	std::string _seed;
+	bool _compare;
+	int _basesLost, _rating;
+
+	/// Gets the current time in nanoseconds.
+	static uint64_t now();
+	/// Carries out the policy for a popup.
+	void handlePopup(State *popup);
+	/// Prints the state of the campaign.
+	void report(int month, uint64_t time);
+	/// Plays the campaign once.
+	int play(bool skipQuiet, std::string &summary);
+public:
+	/// Creates a simulation of a saved campaign.
+	CampaignSimulator(Game *game, const std::string &filename, int months, const std::string &seed, bool compare);
+	/// Loads the data and plays the campaign.
+	int run();
+};
+
+}
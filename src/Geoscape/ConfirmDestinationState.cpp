@@ -320,7 +320,7 @@ void ConfirmDestinationState::btnOkClick(Action *)
 			craft->setIsAutoPatrolling(false);
 		}
 
-		craft->setStatus("STR_OUT");
+		craft->setStatus(CRAFT_OUT);
 	}
 
 	_game->popState();
@@ -382,7 +382,7 @@ void ConfirmDestinationState::btnTransferClick(Action *)
 		targetBase->getCrafts()->push_back(_crafts.front());
 		_crafts.front()->setBase(targetBase, false);
 		_crafts.front()->returnToBase();
-		_crafts.front()->setStatus("STR_OUT");
+		_crafts.front()->setStatus(CRAFT_OUT);
 		if (_crafts.front()->getFuel() <= _crafts.front()->getFuelLimit(targetBase))
 		{
 			_crafts.front()->setLowFuel(true);
@@ -129,6 +129,8 @@
 #include "../Mod/AlienRace.h"
 #include "../Mod/RuleInterface.h"
 #include "../Mod/RuleVideo.h"
+#include "TargetGrid.h"
+#include "../Engine/Parallel.h"
 #include "../fmath.h"
 #include "../fallthrough.h"
 
@@ -139,7 +141,7 @@ namespace OpenXcom
  * Initializes all the elements in the Geoscape screen.
  * @param game Pointer to the core game.
  */
-GeoscapeState::GeoscapeState() : _pause(false), _zoomInEffectDone(false), _zoomOutEffectDone(false), _minimizedDogfights(0), _slowdownCounter(0)
+GeoscapeState::GeoscapeState() : _pause(false), _zoomInEffectDone(false), _zoomOutEffectDone(false), _headless(false), _skipQuiet(true), _minimizedDogfights(0), _slowdownCounter(0), _skippedSteps(0)
 {
 	int screenWidth = Options::baseXGeoscape;
 	int screenHeight = Options::baseYGeoscape;
@@ -546,6 +548,7 @@ void GeoscapeState::handle(Action *action)
 						facility->setBuildTime(0);
 						facility->setIfHadPreviousFacility(false);
 					}
+					xbase->updateCapacity();
 				}
 			}
 			// "ctrl-3"
@@ -851,9 +854,31 @@ void GeoscapeState::timeAdvance()
 		timeSpan = 12 * 5 * 6 * 2 * 24;
 	}
 
+	advanceTime(timeSpan);
 
-	for (int i = 0; i < timeSpan && !_pause; ++i)
+	timeDisplay();
+	_globe->draw();
+}
+
+/**
+ * Advances the game time step by step, calling the respective
+ * triggers, until the steps run out or something needs attention.
+ * @param steps Maximum number of 5 second steps to take.
+ * @return Number of steps taken.
+ */
+int GeoscapeState::advanceTime(int steps)
+{
+	int i = 0;
+	for (; i < steps && !_pause; ++i)
 	{
+		int quiet = getQuietSteps(steps - i);
+		if (quiet > 0)
+		{
+			skipQuietSteps(quiet);
+			i += quiet - 1;
+			continue;
+		}
+
 		TimeTrigger trigger;
 		trigger = _game->getSavedGame()->getTime()->advance();
 		switch (trigger)
@@ -879,9 +904,188 @@ void GeoscapeState::timeAdvance()
 	}
 
 	_pause = !_dogfightsToBeStarted.empty() || _zoomInEffectTimer->isRunning() || _zoomOutEffectTimer->isRunning();
+	return i;
+}
 
-	timeDisplay();
-	_globe->draw();
+/**
+ * Runs the geoscape without anybody watching it: time always
+ * runs at the fastest speed and base defenses are decided
+ * without a battle, or the defense facilities firing first.
+ * Used by the campaign simulator.
+ * @param headless True to run without a player.
+ */
+void GeoscapeState::setHeadless(bool headless)
+{
+	_headless = headless;
+	if (_headless)
+	{
+		_timeSpeed = _btn1Day;
+	}
+}
+
+/**
+ * Takes the oldest popup off the queue, so it can be handled
+ * without showing it. The caller gets ownership of it.
+ * @return Pointer to the popup state, or 0 if there are none.
+ */
+State *GeoscapeState::takePopup()
+{
+	if (_popups.empty())
+	{
+		return 0;
+	}
+	State *state = _popups.front();
+	_popups.pop_front();
+	return state;
+}
+
+/**
+ * Ends all dogfights without fighting them out.
+ * Crafts caught by hunter-killers are shot down,
+ * the others simply break off.
+ */
+void GeoscapeState::abortDogfights()
+{
+	for (auto* dfs : _dogfights)
+	{
+		if (dfs->isUfoAttacking())
+		{
+			dfs->getCraft()->setDamage(dfs->getCraft()->getDamageMax());
+		}
+	}
+	for (auto* dfs : _dogfightsToBeStarted)
+	{
+		if (dfs->isUfoAttacking())
+		{
+			dfs->getCraft()->setDamage(dfs->getCraft()->getDamageMax());
+		}
+	}
+	Collections::deleteAll(_dogfights);
+	Collections::deleteAll(_dogfightsToBeStarted);
+	_minimizedDogfights = 0;
+	_dogfightStartTimer->stop();
+	_dogfightTimer->stop();
+	_zoomInEffectTimer->stop();
+	_zoomOutEffectTimer->stop();
+	_pause = false;
+}
+
+/**
+ * Counts how many of the upcoming 5 second steps would do nothing
+ * but move flying UFOs and count down landed and crashed ones,
+ * so they can be skipped at once. That's the case while all crafts
+ * are at home and no shields need recharging, up to the next
+ * 10 minute trigger, the next UFO countdown running out or the next
+ * UFO getting to its destination, whichever comes first.
+ * Detection and hunting only happen on the bigger triggers, so a
+ * flying UFO far from its destination can't meet anything meanwhile.
+ * The skipped steps draw no random numbers, so the game plays
+ * out exactly the same as when stepping through them.
+ * @param maxSteps Most steps that can be skipped.
+ * @return Number of steps to skip.
+ */
+int GeoscapeState::getQuietSteps(int maxSteps) const
+{
+	SavedGame *save = _game->getSavedGame();
+	if (!_skipQuiet || maxSteps <= 1 || !_dogfights.empty() || !_dogfightsToBeStarted.empty() || save->getEnding() != END_NONE || save->getBases()->empty())
+	{
+		return 0;
+	}
+	if ((_timeSpeed == _btn5Secs || _timeSpeed == _btn1Min) && _game->getMod()->getHunterKillerFastRetarget())
+	{
+		return 0;
+	}
+
+	// the step that fires a bigger trigger has to run normally
+	int steps = std::min(maxSteps, save->getTime()->getStepsToNextTrigger() - 1);
+	for (const auto* ufo : *save->getUfos())
+	{
+		switch (ufo->getStatus())
+		{
+		case Ufo::LANDED:
+			// the step that runs the countdown out lifts the UFO off
+			steps = std::min(steps, (int)ufo->getSecondsRemaining() / 5 - 1);
+			break;
+		case Ufo::CRASHED:
+			if (!ufo->getDetected() || ufo->getSecondsRemaining() == 0)
+			{
+				return 0;
+			}
+			break;
+		case Ufo::FLYING:
+			if (ufo->getDestination() == 0 || ufo->isHunting() || ufo->isEscorting() || ufo->getSpeedRadian() <= 0.0)
+			{
+				return 0;
+			}
+			if (ufo->getShield() == -1 || (ufo->getShield() < ufo->getCraftStats().shieldCapacity && ufo->getCraftStats().shieldRechargeInGeoscape != 0))
+			{
+				return 0;
+			}
+			// every step covers at most one speed worth of distance, the step that arrives has to run normally
+			steps = std::min(steps, (int)(ufo->getDistance(ufo->getDestination()) / ufo->getSpeedRadian()) - 2);
+			break;
+		default:
+			return 0;
+		}
+	}
+	for (const auto* xbase : *save->getBases())
+	{
+		for (const auto* xcraft : *xbase->getCrafts())
+		{
+			if (xcraft->isDestroyed() || xcraft->getDestination() != 0 || xcraft->getStatusId() == CRAFT_OUT)
+			{
+				return 0;
+			}
+			if (xcraft->getShield() < xcraft->getCraftStats().shieldCapacity && xcraft->getCraftStats().shieldRechargeInGeoscape != 0)
+			{
+				return 0;
+			}
+		}
+	}
+	for (auto* way : *save->getWaypoints())
+	{
+		if (way->getFollowers()->empty())
+		{
+			return 0;
+		}
+	}
+	return std::max(steps, 0);
+}
+
+/**
+ * Advances the game through steps found by getQuietSteps(),
+ * moving the flying UFOs and counting down the landed ones on the way.
+ * @param steps Number of 5 second steps.
+ */
+void GeoscapeState::skipQuietSteps(int steps)
+{
+	SavedGame *save = _game->getSavedGame();
+	save->getTime()->skip(steps);
+	for (auto* ufo : *save->getUfos())
+	{
+		if (ufo->getStatus() == Ufo::LANDED)
+		{
+			ufo->setSecondsRemaining(ufo->getSecondsRemaining() - 5 * steps);
+		}
+		else if (ufo->getStatus() == Ufo::FLYING)
+		{
+			for (int i = 0; i < steps; ++i)
+			{
+				ufo->think();
+			}
+		}
+	}
+	_skippedSteps += steps;
+}
+
+/**
+ * Turns skipping of quiet steps on or off, to check that the
+ * game plays out the same either way.
+ * @param skip True to skip quiet steps.
+ */
+void GeoscapeState::setSkipQuietSteps(bool skip)
+{
+	_skipQuiet = skip;
 }
 
 /**
@@ -895,7 +1099,7 @@ const std::vector<Craft*>* GeoscapeState::updateActiveCrafts()
 	{
 		for (auto* xcraft : *xbase->getCrafts())
 		{
-			if (xcraft->getStatus() == "STR_OUT" && !xcraft->isDestroyed())
+			if (xcraft->getStatusId() == CRAFT_OUT && !xcraft->isDestroyed())
 			{
 				_activeCrafts.push_back(xcraft);
 			}
@@ -1036,7 +1240,8 @@ void GeoscapeState::time5Seconds()
 					ufo->setDestination(0);
 					base->setupDefenses(mission);
 					timerReset();
-					if (!base->getDefenses()->empty() && !ufo->getMission()->getRules().ignoreBaseDefenses())
+					// without a player the defense screen would never run, go straight to the ground assault
+					if (!base->getDefenses()->empty() && !ufo->getMission()->getRules().ignoreBaseDefenses() && !_headless)
 					{
 						popup(new BaseDefenseState(base, ufo, this));
 						return; // don't allow multiple simultaneous attacks in the same game tick
@@ -1378,7 +1583,7 @@ void GeoscapeState::time5Seconds()
 				}
 				else if (x != 0)
 				{
-					if (x->getStatus() != "STR_OUT" || x->isDestroyed())
+					if (x->getStatusId() != CRAFT_OUT || x->isDestroyed())
 					{
 						xcraft->returnToBase();
 					}
@@ -1492,7 +1697,7 @@ void GeoscapeState::time10Minutes()
 		// Fuel consumption for XCOM craft.
 		for (auto* xcraft : *xbase->getCrafts())
 		{
-			if (xcraft->getStatus() == "STR_OUT")
+			if (xcraft->getStatusId() == CRAFT_OUT)
 			{
 				int escortSpeed = 0;
 				{
@@ -1575,6 +1780,22 @@ void GeoscapeState::ufoHuntingAndEscorting()
 {
 	auto* activeCrafts = updateActiveCrafts();
 
+	int maxRadarRange = 0;
+	for (const auto* ufo : *_game->getSavedGame()->getUfos())
+	{
+		if (ufo->isHunterKiller() && ufo->getStatus() == Ufo::FLYING)
+		{
+			maxRadarRange = std::max(maxRadarRange, ufo->getCraftStats().radarRange);
+		}
+	}
+	TargetGrid crafts;
+	crafts.reset(Nautical(maxRadarRange + 1));
+	for (const auto* craft : *activeCrafts)
+	{
+		crafts.insert(craft);
+	}
+	crafts.finish();
+
 	for (auto* ufo : *_game->getSavedGame()->getUfos())
 	{
 		if (ufo->isHunterKiller() && ufo->getStatus() == Ufo::FLYING)
@@ -1596,9 +1817,11 @@ void GeoscapeState::ufoHuntingAndEscorting()
 				}
 			}
 
-			// look for more attractive target
-			for (auto* craft : *activeCrafts)
+			// look for more attractive target, among the crafts that can be in radar range
+			crafts.query(ufo->getLongitude(), ufo->getLatitude(), Nautical(ufo->getCraftStats().radarRange + 1), _nearbyTargets);
+			for (int i : _nearbyTargets)
 			{
+				Craft *craft = activeCrafts->at(i);
 				if (!craft->isIgnoredByHK() && !craft->getRules()->isUndetectable())
 				{
 					int tmpAttraction = craft->getHunterKillerAttraction(ufo->getHuntMode());
@@ -1665,6 +1888,19 @@ void GeoscapeState::baseHunting()
 {
 	auto* activeCrafts = updateActiveCrafts();
 
+	double maxDetectionRange = 0.0;
+	for (const auto* ab : *_game->getSavedGame()->getAlienBases())
+	{
+		maxDetectionRange = std::max(maxDetectionRange, ab->getDeployment()->getBaseDetectionRange());
+	}
+	TargetGrid crafts;
+	crafts.reset(Nautical(maxDetectionRange + 1));
+	for (const auto* craft : *activeCrafts)
+	{
+		crafts.insert(craft);
+	}
+	crafts.finish();
+
 	for (auto* ab : *_game->getSavedGame()->getAlienBases())
 	{
 		if (ab->getDeployment()->getBaseDetectionRange() > 0)
@@ -1677,10 +1913,12 @@ void GeoscapeState::baseHunting()
 			{
 				// Look for nearby craft
 				bool started = false;
-				for (auto* craft : *activeCrafts)
+				crafts.query(ab->getLongitude(), ab->getLatitude(), Nautical(ab->getDeployment()->getBaseDetectionRange() + 1), _nearbyTargets);
+				for (int i : _nearbyTargets)
 				{
+					Craft *craft = activeCrafts->at(i);
 					// Craft is flying (i.e. not in base)
-					if (craft->getStatus() == "STR_OUT" && !craft->isDestroyed() && !craft->getRules()->isUndetectable() && !craft->isIgnoredByHK())
+					if (craft->getStatusId() == CRAFT_OUT && !craft->isDestroyed() && !craft->getRules()->isUndetectable() && !craft->isIgnoredByHK())
 					{
 						// Craft is close enough and RNG is in our favour
 						if (craft->getDistance(ab) < Nautical(ab->getDeployment()->getBaseDetectionRange()) && RNG::percent(ab->getDeployment()->getBaseDetectionChance()))
@@ -1878,20 +2116,20 @@ void GeoscapeState::time30Minutes()
 	{
 		for (auto* xcraft : *xbase->getCrafts())
 		{
-			if (xcraft->getStatus() == "STR_REFUELLING")
+			if (xcraft->getStatusId() == CRAFT_REFUELLING)
 			{
 				std::string item = xcraft->refuel();
 
 				if (item.empty())
 				{
 					// notification
-					if (xcraft->getStatus() == "STR_READY" && xcraft->getRules()->notifyWhenRefueled())
+					if (xcraft->getStatusId() == CRAFT_READY && xcraft->getRules()->notifyWhenRefueled())
 					{
 						std::string msg = tr("STR_CRAFT_IS_READY").arg(xcraft->getName(_game->getLanguage())).arg(xbase->getName());
 						popup(new CraftErrorState(this, msg));
 					}
 					// auto-patrol
-					if (xcraft->getStatus() == "STR_READY" && xcraft->getRules()->canAutoPatrol())
+					if (xcraft->getStatusId() == CRAFT_READY && xcraft->getRules()->canAutoPatrol())
 					{
 						if (xcraft->getIsAutoPatrolling())
 						{
@@ -1904,7 +2142,7 @@ void GeoscapeState::time30Minutes()
 								_game->getSavedGame()->getWaypoints()->push_back(w);
 							}
 							xcraft->setDestination(w);
-							xcraft->setStatus("STR_OUT");
+							xcraft->setStatus(CRAFT_OUT);
 						}
 					}
 				}
@@ -1923,6 +2161,30 @@ void GeoscapeState::time30Minutes()
 	// can be updated by previous loop
 	auto* activeCrafts = updateActiveCrafts();
 
+	// Index the bases and crafts by position, so each UFO only looks at those in radar range
+	int maxRadarRange = 0;
+	for (const auto* xbase : *_game->getSavedGame()->getBases())
+	{
+		maxRadarRange = std::max(maxRadarRange, xbase->getMaxRadarRange());
+	}
+	for (const auto* craft : *activeCrafts)
+	{
+		maxRadarRange = std::max(maxRadarRange, craft->getCraftStats().radarRange);
+	}
+	// detection compares whole nautical miles, leave a mile of margin
+	double detectorRange = Nautical(maxRadarRange + 1);
+	TargetGrid detectors;
+	detectors.reset(detectorRange);
+	for (const auto* xbase : *_game->getSavedGame()->getBases())
+	{
+		detectors.insert(xbase);
+	}
+	for (const auto* craft : *activeCrafts)
+	{
+		detectors.insert(craft);
+	}
+	detectors.finish();
+
 	// Handle UFO detection and give aliens points
 	for (auto* ufo : *_game->getSavedGame()->getUfos())
 	{
@@ -1959,7 +2221,7 @@ void GeoscapeState::time30Minutes()
 			}
 
 			// Detection ufo state
-			ufoDetection(ufo, activeCrafts);
+			ufoDetection(ufo, activeCrafts, detectors, detectorRange);
 
 			break;
 		case Ufo::CRASHED:
@@ -2010,11 +2272,40 @@ void GeoscapeState::time30Minutes()
 	);
 }
 
+namespace
+{
+
+/**
+ * Checks if a script hook has any code, either
+ * its own or in the global events before and after it.
+ * @param script Script container of the hook.
+ * @return True if there is something to run.
+ */
+template<typename Container>
+bool hasScriptCode(const Container &script)
+{
+	if (script.data())
+	{
+		return true;
+	}
+	const auto *events = script.dataEvents();
+	return events && (events[0] || events[1]);
+}
+
+}
+
 /**
  * Logic responsible for detecting ufo and its tracking.
- * @param ufo
+ * Without detection scripts, bases and crafts out of radar range
+ * can't see the UFO, so only the ones the grid finds nearby are asked.
+ * The others still use up their random roll, to keep the game
+ * the same as when every base and craft was asked.
+ * @param ufo The UFO to detect.
+ * @param activeCrafts Crafts out of their bases.
+ * @param detectors Grid of the bases followed by the active crafts.
+ * @param detectorRange Longest radar range of the detectors, in radians.
  */
-void GeoscapeState::ufoDetection(Ufo* ufo, const std::vector<Craft*>* activeCrafts)
+void GeoscapeState::ufoDetection(Ufo* ufo, const std::vector<Craft*>* activeCrafts, const TargetGrid &detectors, double detectorRange)
 {
 	auto maskTest = [](UfoDetection value, UfoDetection mask)
 	{
@@ -2029,14 +2320,45 @@ void GeoscapeState::ufoDetection(Ufo* ufo, const std::vector<Craft*>* activeCraf
 	auto alreadyTracked = ufo->getDetected();
 	auto save = _game->getSavedGame();
 
-	for (auto* base : *_game->getSavedGame()->getBases())
+	auto* bases = _game->getSavedGame()->getBases();
+	const int baseCount = bases->size();
+	auto detect = [&](int i)
 	{
-		detected = maskBitOr(detected, base->detect(ufo, save, alreadyTracked));
-	}
+		if (i < baseCount)
+		{
+			detected = maskBitOr(detected, bases->at(i)->detect(ufo, save, alreadyTracked));
+		}
+		else
+		{
+			detected = maskBitOr(detected, activeCrafts->at(i - baseCount)->detect(ufo, save, alreadyTracked));
+		}
+	};
 
-	for (auto* craft : *activeCrafts)
+	if (hasScriptCode(ufo->getRules()->getScript<ModScript::DetectUfoFromBase>()) || hasScriptCode(ufo->getRules()->getScript<ModScript::DetectUfoFromCraft>()))
 	{
-		detected = maskBitOr(detected, craft->detect(ufo, save, alreadyTracked));
+		// scripts can see past the radar range
+		for (int i = 0; i < detectors.size(); ++i)
+		{
+			detect(i);
+		}
+	}
+	else
+	{
+		detectors.query(ufo->getLongitude(), ufo->getLatitude(), detectorRange, _nearbyTargets);
+		int next = 0;
+		for (int i : _nearbyTargets)
+		{
+			for (; next < i; ++next)
+			{
+				RNG::percent(0);
+			}
+			detect(i);
+			++next;
+		}
+		for (; next < detectors.size(); ++next)
+		{
+			RNG::percent(0);
+		}
 	}
 
 	if (!alreadyTracked)
@@ -2085,11 +2407,11 @@ void GeoscapeState::time1Hour()
 	{
 		for (auto* xcraft : *xbase->getCrafts())
 		{
-			if (xcraft->getStatus() == "STR_REPAIRS")
+			if (xcraft->getStatusId() == CRAFT_REPAIRS)
 			{
 				xcraft->repair();
 			}
-			else if (xcraft->getStatus() == "STR_REARMING")
+			else if (xcraft->getStatusId() == CRAFT_REARMING)
 			{
 				auto* ammo = xcraft->rearm();
 				if (ammo)
@@ -2101,7 +2423,7 @@ void GeoscapeState::time1Hour()
 					popup(new CraftErrorState(this, msg));
 				}
 			}
-			if (xcraft->getShieldCapacity() > 0 && xcraft->getStatus() != "STR_OUT")
+			if (xcraft->getShieldCapacity() > 0 && xcraft->getStatusId() != CRAFT_OUT)
 			{
 				// Recharge craft shields in parallel (no wait for repair/rearm/refuel)
 				xcraft->setShield(xcraft->getShield() + xcraft->getRules()->getShieldRechargeAtBase());
@@ -2155,9 +2477,9 @@ void GeoscapeState::time1Hour()
 			{
 				std::map<int, int> prisonTypes;
 				RuleItem *rule = nullptr;
-				for (const auto& item : *xbase->getStorageItems()->getContents())
+				for (const auto& item : *xbase->getStorageItems())
 				{
-					rule = _game->getMod()->getItem(item.first, true);
+					rule = item.first;
 					if (rule->isAlien())
 					{
 						prisonTypes[rule->getPrisonType()] += 1;
@@ -2305,6 +2627,93 @@ void GenerateSupplyMission::operator()(AlienBase *base) const
 	}
 }
 
+namespace
+{
+
+/**
+ * What happened in a base during the daily update,
+ * to be reported once all bases are done.
+ */
+struct BaseDailyResult
+{
+	RNG::RandomState rng;
+	std::map<const RuleBaseFacility*, int> finishedFacilities;
+	std::vector<Soldier*> trainingFinished, psiTrainingFinished;
+};
+
+/**
+ * Does the daily work that only concerns a single base:
+ * facility construction, soldier recovery and training.
+ * Runs on any thread, so it can't raise popups or use the global random generator.
+ * @param xbase Pointer to the base.
+ * @param mod Pointer to the mod.
+ * @param psiStrengthEval Can the player see psi strength?
+ * @param result Random sequence to use, and what happened to show later.
+ */
+void dailyBaseProgress(Base *xbase, const Mod *mod, bool psiStrengthEval, BaseDailyResult &result)
+{
+	for (auto* facility : *xbase->getFacilities())
+	{
+		if (facility->getBuildTime() > 0)
+		{
+			facility->build();
+			if (facility->getBuildTime() == 0)
+			{
+				result.finishedFacilities[facility->getRules()] += 1;
+			}
+		}
+	}
+	if (!result.finishedFacilities.empty())
+	{
+		xbase->updateCapacity();
+	}
+
+	BaseSumDailyRecovery recovery = xbase->getSumRecoveryPerDay();
+	for (auto* soldier : *xbase->getSoldiers())
+	{
+		soldier->replenishStats(recovery);
+
+		if (soldier->isInTraining())
+		{
+			soldier->trainPhys(mod->getCustomTrainingFactor(), result.rng);
+			soldier->calcStatString(mod->getStatStrings(), psiStrengthEval);
+			if (soldier->isFullyTrained())
+			{
+				soldier->setTraining(false);
+				result.trainingFinished.push_back(soldier);
+			}
+		}
+		else
+		{
+			if (soldier->getReturnToTrainingWhenHealed() && !soldier->isWounded())
+			{
+				if (!soldier->isFullyTrained() && xbase->getFreeTrainingSpace() > 0)
+				{
+					soldier->setTraining(true);
+				}
+				// only ever try to return once
+				soldier->setReturnToTrainingWhenHealed(false);
+			}
+		}
+	}
+
+	if (xbase->getAvailablePsiLabs() > 0 && Options::anytimePsiTraining)
+	{
+		for (auto* s : *xbase->getSoldiers())
+		{
+			s->trainPsi1Day(result.rng);
+			s->calcStatString(mod->getStatStrings(), psiStrengthEval);
+			if (s->isInPsiTraining() && s->isFullyPsiTrained())
+			{
+				s->setPsiTraining(false);
+				result.psiTrainingFinished.push_back(s);
+			}
+		}
+	}
+}
+
+}
+
 /**
  * Takes care of any game logic that has to
  * run every game day, like constructions.
@@ -2314,22 +2723,27 @@ void GeoscapeState::time1Day()
 	SavedGame *saveGame = _game->getSavedGame();
 	Mod *mod = _game->getMod();
 	bool psiStrengthEval = (Options::psiStrengthEval && saveGame->isResearched(mod->getPsiRequirements()));
-	for (auto* xbase : *_game->getSavedGame()->getBases())
+
+	// Construction and soldier recovery and training only touch their own base,
+	// so all bases are done at once first, each with its own random sequence
+	std::vector<BaseDailyResult> daily(saveGame->getBases()->size());
+	for (auto& result : daily)
 	{
-		// Handle facility construction
-		std::map<const RuleBaseFacility*, int> finishedFacilities;
-		for (auto* facility : *xbase->getFacilities())
+		result.rng = RNG::globalRandomState().subSequence();
+	}
+	Parallel::forEach(daily.size(), [&](int i)
 		{
-			if (facility->getBuildTime() > 0)
-			{
-				facility->build();
-				if (facility->getBuildTime() == 0)
-				{
-					finishedFacilities[facility->getRules()] += 1;
-				}
-			}
+			dailyBaseProgress(saveGame->getBases()->at(i), mod, psiStrengthEval, daily[i]);
 		}
-		for (const auto& pair : finishedFacilities)
+	);
+
+	for (size_t baseIndex = 0; baseIndex < saveGame->getBases()->size(); ++baseIndex)
+	{
+		Base *xbase = saveGame->getBases()->at(baseIndex);
+		const BaseDailyResult &result = daily[baseIndex];
+
+		// Handle facility construction
+		for (const auto& pair : result.finishedFacilities)
 		{
 			if (pair.second > 1)
 			{
@@ -2522,58 +2936,14 @@ void GeoscapeState::time1Day()
 			saveGame->handlePrimaryResearchSideEffects(topicsToCheck, _game->getMod(), xbase);
 		}
 
-		// Handle soldier wounds and martial training
-		BaseSumDailyRecovery recovery = xbase->getSumRecoveryPerDay();
-		std::vector<Soldier *> trainingFinishedList;
-		for (auto* soldier : *xbase->getSoldiers())
+		// Handle soldier wounds, martial and psionic training
+		if (!result.trainingFinished.empty())
 		{
-			soldier->replenishStats(recovery);
-
-			if (soldier->isInTraining())
-			{
-				soldier->trainPhys(_game->getMod()->getCustomTrainingFactor());
-				soldier->calcStatString(_game->getMod()->getStatStrings(), psiStrengthEval);
-				if (soldier->isFullyTrained())
-				{
-					soldier->setTraining(false);
-					trainingFinishedList.push_back(soldier);
-				}
-			}
-			else
-			{
-				if (soldier->getReturnToTrainingWhenHealed() && !soldier->isWounded())
-				{
-					if (!soldier->isFullyTrained() && xbase->getFreeTrainingSpace() > 0)
-					{
-						soldier->setTraining(true);
-					}
-					// only ever try to return once
-					soldier->setReturnToTrainingWhenHealed(false);
-				}
-			}
+			popup(new TrainingFinishedState(xbase, result.trainingFinished, false));
 		}
-		if (!trainingFinishedList.empty())
+		if (!result.psiTrainingFinished.empty())
 		{
-			popup(new TrainingFinishedState(xbase, trainingFinishedList, false));
-		}
-		// Handle psionic training
-		if (xbase->getAvailablePsiLabs() > 0 && Options::anytimePsiTraining)
-		{
-			std::vector<Soldier*> psiTrainingFinishedList;
-			for (auto* s : *xbase->getSoldiers())
-			{
-				s->trainPsi1Day();
-				s->calcStatString(_game->getMod()->getStatStrings(), psiStrengthEval);
-				if (s->isInPsiTraining() && s->isFullyPsiTrained())
-				{
-					s->setPsiTraining(false);
-					psiTrainingFinishedList.push_back(s);
-				}
-			}
-			if (!psiTrainingFinishedList.empty())
-			{
-				popup(new TrainingFinishedState(xbase, psiTrainingFinishedList, true));
-			}
+			popup(new TrainingFinishedState(xbase, result.psiTrainingFinished, true));
 		}
 	}
 
@@ -2755,20 +3125,29 @@ void GeoscapeState::time1Month()
 	if (!Options::anytimePsiTraining)
 	{
 		bool psiStrengthEval = (Options::psiStrengthEval && _game->getSavedGame()->isResearched(_game->getMod()->getPsiRequirements()));
-		for (auto* xbase : *_game->getSavedGame()->getBases())
+		auto* bases = _game->getSavedGame()->getBases();
+		std::vector<RNG::RandomState> rngs;
+		for (size_t i = 0; i < bases->size(); ++i)
 		{
-			if (xbase->getAvailablePsiLabs() > 0)
+			rngs.push_back(RNG::globalRandomState().subSequence());
+		}
+		// every base trains its own soldiers, with its own random sequence
+		Parallel::forEach(bases->size(), [&](int i)
 			{
-				for (auto* soldier : *xbase->getSoldiers())
+				Base *xbase = bases->at(i);
+				if (xbase->getAvailablePsiLabs() > 0)
 				{
-					if (soldier->isInPsiTraining())
+					for (auto* soldier : *xbase->getSoldiers())
 					{
-						soldier->trainPsi();
-						soldier->calcStatString(_game->getMod()->getStatStrings(), psiStrengthEval);
+						if (soldier->isInPsiTraining())
+						{
+							soldier->trainPsi(rngs[i]);
+							soldier->calcStatString(_game->getMod()->getStatStrings(), psiStrengthEval);
+						}
 					}
 				}
 			}
-		}
+		);
 	}
 
 	// Handle funding
@@ -2797,6 +3176,10 @@ void GeoscapeState::time1Month()
  */
 void GeoscapeState::timerReset()
 {
+	if (_headless)
+	{
+		return;
+	}
 	SDL_Event ev;
 	ev.button.button = SDL_BUTTON_LEFT;
 	Action act(&ev, _game->getScreen()->getXScale(), _game->getScreen()->getYScale(), _game->getScreen()->getCursorTopBlackBand(), _game->getScreen()->getCursorLeftBlackBand());
@@ -3411,6 +3794,18 @@ void GeoscapeState::handleBaseDefense(Base *base, Ufo *ufo)
 			popup(new BaseDestroyedState(base, true, true));
 		}
 	}
+	else if (_headless && (base->getAvailableSoldiers(true, true) > 0 || !base->getVehicles()->empty()))
+	{
+		if (resolveBaseDefense(base, ufo))
+		{
+			// give back the vehicles and ammo set aside by setupDefenses()
+			base->cleanupDefenses(true);
+		}
+		else
+		{
+			popup(new BaseDestroyedState(base, false, false));
+		}
+	}
 	else if (base->getAvailableSoldiers(true, true) > 0 || !base->getVehicles()->empty())
 	{
 		SavedBattleGame *bgame = new SavedBattleGame(_game->getMod(), _game->getLanguage());
@@ -3435,6 +3830,38 @@ void GeoscapeState::handleBaseDefense(Base *base, Ufo *ufo)
 	}
 }
 
+/**
+ * Decides a base defense from the size of both sides instead of
+ * playing it out, for headless runs. The defenders hold with a
+ * chance of their share of all the units in the battle.
+ * @param base Base under attack.
+ * @param ufo Ufo attacking the base.
+ * @return True if the base holds.
+ */
+bool GeoscapeState::resolveBaseDefense(Base *base, Ufo *ufo)
+{
+	const AlienDeployment *deployment = _game->getMod()->getDeployment(ufo->getCraftStats().missionCustomDeploy);
+	if (!deployment)
+	{
+		deployment = _game->getMod()->getDeployment("STR_BASE_DEFENSE");
+	}
+	int aliens = 0;
+	if (deployment)
+	{
+		int difficulty = _game->getSavedGame()->getDifficulty();
+		for (const auto& dd : *deployment->getDeploymentData())
+		{
+			aliens += dd.lowQty + (dd.highQty - dd.lowQty) * difficulty / 4;
+		}
+	}
+	int defenders = base->getAvailableSoldiers(true, true) + (int)base->getVehicles()->size();
+	if (aliens <= 0)
+	{
+		return true;
+	}
+	return RNG::percent(defenders * 100 / (defenders + aliens));
+}
+
 /**
  * Determine the alien missions to start this month.
  */
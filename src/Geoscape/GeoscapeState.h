@@ -36,6 +36,7 @@ class Ufo;
 class MissionSite;
 class Base;
 class RuleMissionScript;
+class TargetGrid;
 
 /**
  * Geoscape screen which shows an overview of
@@ -53,18 +54,26 @@ private:
 	InteractiveSurface *_btnRotateLeft, *_btnRotateRight, *_btnRotateUp, *_btnRotateDown, *_btnZoomIn, *_btnZoomOut;
 	Text *_txtFunds, *_txtHour, *_txtHourSep, *_txtMin, *_txtMinSep, *_txtSec, *_txtWeekday, *_txtDay, *_txtMonth, *_txtYear;
 	Timer *_gameTimer, *_zoomInEffectTimer, *_zoomOutEffectTimer, *_dogfightStartTimer, *_dogfightTimer;
-	bool _pause, _zoomInEffectDone, _zoomOutEffectDone;
+	bool _pause, _zoomInEffectDone, _zoomOutEffectDone, _headless, _skipQuiet;
 	Text *_txtDebug;
 	ComboBox *_cbxRegion, *_cbxZone, *_cbxArea, *_cbxCountry;
 	Text *_txtSlacking;
 	std::list<State*> _popups;
 	std::list<DogfightState*> _dogfights, _dogfightsToBeStarted;
 	std::vector<Craft*> _activeCrafts;
+	std::vector<int> _nearbyTargets;
 	size_t _minimizedDogfights;
 	int _slowdownCounter;
+	int _skippedSteps;
 
 	/// Update list of active crafts.
 	const std::vector<Craft*>* updateActiveCrafts();
+	/// Counts the upcoming 5 second steps where nothing can happen.
+	int getQuietSteps(int maxSteps) const;
+	/// Advances through steps where nothing can happen.
+	void skipQuietSteps(int steps);
+	/// Decides a base defense without a battle.
+	bool resolveBaseDefense(Base *base, Ufo *ufo);
 
 	void cbxRegionChange(Action *action);
 	void cbxZoneChange(Action *action);
@@ -87,6 +96,20 @@ public:
 	void timeDisplay();
 	/// Advances the game timer.
 	void timeAdvance();
+	/// Advances the game time by a number of 5 second steps.
+	int advanceTime(int steps);
+	/// Runs the geoscape without a player.
+	void setHeadless(bool headless);
+	/// Is the geoscape run without a player?
+	bool isHeadless() const { return _headless; }
+	/// Turns skipping of quiet steps on or off.
+	void setSkipQuietSteps(bool skip);
+	/// Gets the number of steps skipped so far.
+	int getSkippedSteps() const { return _skippedSteps; }
+	/// Takes the next popup off the queue.
+	State *takePopup();
+	/// Ends all dogfights at once.
+	void abortDogfights();
 	/// Trigger whenever 5 seconds pass.
 	void time5Seconds();
 	/// Trigger whenever 10 minutes pass.
@@ -95,7 +118,7 @@ public:
 	void baseHunting();
 	/// Trigger whenever 30 minutes pass.
 	void time30Minutes();
-	void ufoDetection(Ufo* ufo, const std::vector<Craft*>* activeCrafts);
+	void ufoDetection(Ufo* ufo, const std::vector<Craft*>* activeCrafts, const TargetGrid &detectors, double detectorRange);
 	/// Trigger whenever 1 hour passes.
 	void time1Hour();
 	/// Trigger whenever 1 day passes.
@@ -17,6 +17,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "Globe.h"
+#include "LandingPointPool.h"
 #include "../fmath.h"
 #include "../Engine/Action.h"
 #include "../Engine/SurfaceSet.h"
@@ -342,6 +343,7 @@ Globe::Globe(Game* game, int cenX, int cenY, int width, int height, int x, int y
 	_markers = new Surface(width, height, x, y);
 	_radars = new Surface(width, height, x, y);
 	_clipper = new FastLineClip(x, x+width, y, y+height);
+	_landingPoints = new LandingPointPool();
 
 	// Animation timers
 	_blinkTimer = new Timer(100);
@@ -373,6 +375,7 @@ Globe::~Globe()
 	delete _texture;
 	delete _radars;
 	delete _clipper;
+	delete _landingPoints;
 
 	for (auto* polygon : _cacheLand)
 	{
@@ -1218,7 +1221,7 @@ void Globe::drawRadars()
 		// Draw radars around player craft
 		for (auto* xcraft : *xbase->getCrafts())
 		{
-			if (xcraft->getStatus() != "STR_OUT")
+			if (xcraft->getStatusId() != CRAFT_OUT)
 				continue;
 			lat = xcraft->getLatitude();
 			lon = xcraft->getLongitude();
@@ -1650,7 +1653,7 @@ void Globe::drawFlights()
 		for (auto* xcraft : *xbase->getCrafts())
 		{
 			// Hide crafts docked at base
-			if (xcraft->getStatus() != "STR_OUT" || xcraft->getDestination() == 0 /*|| pointBack(xcraft->getLongitude(), xcraft->getLatitude())*/)
+			if (xcraft->getStatusId() != CRAFT_OUT || xcraft->getDestination() == 0 /*|| pointBack(xcraft->getLongitude(), xcraft->getLatitude())*/)
 				continue;
 
 			double lon1 = xcraft->getLongitude();
@@ -34,6 +34,7 @@ class Target;
 class LocalizedText;
 class RuleGlobe;
 class Craft;
+class LandingPointPool;
 
 /**
  * Interactive globe view of the world.
@@ -66,6 +67,7 @@ private:
 	Timer *_blinkTimer, *_rotTimer;
 	std::list<Polygon*> _cacheLand;
 	FastLineClip *_clipper;
+	LandingPointPool *_landingPoints;
 	double _radius, _radiusStep;
 	///normal of each pixel in earth globe per zoom level
 	std::vector<std::vector<Cord> > _earthData;
@@ -157,6 +159,8 @@ public:
 	bool insideLand(double lon, double lat) const;
 	/// Checks if a point is inside fakeUnderwater texture.
 	bool insideFakeUnderwaterTexture(double lon, double lat) const;
+	/// Gets the places in mission zones where UFOs can land.
+	LandingPointPool &getLandingPoints() const { return *_landingPoints; }
 	/// Turns on/off the globe detail.
 	void toggleDetail();
 	/// Gets all the targets near a point on the globe.
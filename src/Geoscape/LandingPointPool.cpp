@@ -0,0 +1,179 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "LandingPointPool.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include "Globe.h"
+#include "../Engine/RNG.h"
+#include "../Mod/RuleRegion.h"
+
+namespace OpenXcom
+{
+
+namespace
+{
+
+/// Number of grid cells along each side of a mission area.
+const int LandingGridSize = 32;
+
+}
+
+/**
+ * Checks if a point is a place a UFO can land on.
+ * @param globe Globe with the land and its textures.
+ * @param region Region of the mission zone.
+ * @param area Area of the zone, or -1 for the whole zone, which also keeps the point inside the region.
+ * @param fakeWater Wants a point on a fake underwater texture instead of plain land.
+ * @param lon Longitude of the point.
+ * @param lat Latitude of the point.
+ * @return True if the point is valid.
+ */
+bool LandingPointPool::isValid(const Globe &globe, const RuleRegion &region, int area, bool fakeWater, double lon, double lat)
+{
+	if (!globe.insideLand(lon, lat))
+	{
+		return false;
+	}
+	if (area == -1 && !region.insideRegion(lon, lat))
+	{
+		return false;
+	}
+	return globe.insideFakeUnderwaterTexture(lon, lat) == fakeWater;
+}
+
+/**
+ * Gets the valid cells of a mission zone. The first time a zone
+ * is asked for, every cell of the grid over its areas is checked.
+ * @param globe Globe with the land and its textures.
+ * @param region Region of the mission zone.
+ * @param zone Mission zone in the region.
+ * @param area Area of the zone, or -1 for all of them.
+ * @return Pool of valid cells.
+ */
+const LandingPointPool::Pool &LandingPointPool::getPool(const Globe &globe, const RuleRegion &region, size_t zone, int area)
+{
+	auto key = std::make_tuple(&region, zone, area);
+	auto i = _pools.find(key);
+	if (i != _pools.end())
+	{
+		return i->second;
+	}
+
+	Pool &pool = _pools[key];
+	const std::vector<MissionArea> &areas = region.getMissionZones().at(zone).areas;
+	size_t first = area == -1 ? 0 : area;
+	size_t last = area == -1 ? areas.size() : area + 1;
+	// valid cells and grid size of each area, to check the odds against getRandomPoint()
+	std::vector<std::tuple<int, int, int>> counts;
+	for (size_t a = first; a < last; ++a)
+	{
+		const MissionArea &ma = areas[a];
+		double lonMin = std::min(ma.lonMin, ma.lonMax);
+		double lonMax = std::max(ma.lonMin, ma.lonMax);
+		double latMin = std::min(ma.latMin, ma.latMax);
+		double latMax = std::max(ma.latMin, ma.latMax);
+		// a point is a single cell standing in for a whole grid, so every area
+		// has the same total weight and is picked as often as by getRandomPoint()
+		int size = ma.isPoint() ? 1 : LandingGridSize;
+		int weight = LandingGridSize * LandingGridSize / (size * size);
+		double cellLon = (lonMax - lonMin) / size;
+		double cellLat = (latMax - latMin) / size;
+		int landCells = 0, fakeWaterCells = 0;
+		for (int x = 0; x < size; ++x)
+		{
+			for (int y = 0; y < size; ++y)
+			{
+				Cell cell = { lonMin + (x + 0.5) * cellLon, latMin + (y + 0.5) * cellLat, cellLon / 2, cellLat / 2, weight };
+				if (!globe.insideLand(cell.lon, cell.lat) || (area == -1 && !region.insideRegion(cell.lon, cell.lat)))
+				{
+					continue;
+				}
+				bool fakeWater = globe.insideFakeUnderwaterTexture(cell.lon, cell.lat);
+				std::vector<Cell> &cells = fakeWater ? pool.fakeWater : pool.land;
+				if (!cells.empty())
+				{
+					cell.weightSum += cells.back().weightSum;
+				}
+				cells.push_back(cell);
+				++(fakeWater ? fakeWaterCells : landCells);
+			}
+		}
+		counts.push_back(std::make_tuple(landCells, fakeWaterCells, size));
+	}
+#ifndef NDEBUG
+	// getRandomPoint() picks an area uniformly and keeps the point with the odds
+	// of the valid share of that area, so each area's odds must match its weight
+	for (int fakeWater = 0; fakeWater < 2; ++fakeWater)
+	{
+		const std::vector<Cell> &cells = fakeWater ? pool.fakeWater : pool.land;
+		double oldTotal = 0.0;
+		for (const auto &c : counts)
+		{
+			oldTotal += (double)(fakeWater ? std::get<1>(c) : std::get<0>(c)) / (std::get<2>(c) * std::get<2>(c));
+		}
+		for (const auto &c : counts)
+		{
+			int valid = fakeWater ? std::get<1>(c) : std::get<0>(c);
+			int size = std::get<2>(c);
+			double oldOdds = (double)valid / (size * size) / oldTotal;
+			double newOdds = (double)valid * (LandingGridSize * LandingGridSize / (size * size)) / cells.back().weightSum;
+			assert((valid == 0 || std::abs(oldOdds - newOdds) < 1e-9) && "Landing area odds differ from getRandomPoint()");
+		}
+	}
+#endif
+	return pool;
+}
+
+/**
+ * Picks a random landing point in a mission zone: a random valid
+ * cell by weight, then a random point in that cell, falling back to the
+ * center of the cell when the point misses the ground.
+ * @param globe Globe with the land and its textures.
+ * @param region Region of the mission zone.
+ * @param zone Mission zone in the region.
+ * @param area Area of the zone, or -1 for all of them, which also keeps the point inside the region.
+ * @param fakeWater Wants a point on a fake underwater texture instead of plain land.
+ * @param pos Returns the landing point.
+ * @return False if the zone has no valid ground at all.
+ */
+bool LandingPointPool::getPoint(const Globe &globe, const RuleRegion &region, size_t zone, int area, bool fakeWater, std::pair<double, double> &pos)
+{
+	const Pool &pool = getPool(globe, region, zone, area);
+	const std::vector<Cell> &cells = fakeWater ? pool.fakeWater : pool.land;
+	if (cells.empty())
+	{
+		return false;
+	}
+	int pick = RNG::generate(0, cells.back().weightSum - 1);
+	const Cell &cell = *std::upper_bound(cells.begin(), cells.end(), pick, [](int w, const Cell &c) { return w < c.weightSum; });
+	double lon = RNG::generate(cell.lon - cell.halfLon, cell.lon + cell.halfLon);
+	double lat = RNG::generate(cell.lat - cell.halfLat, cell.lat + cell.halfLat);
+	if (isValid(globe, region, area, fakeWater, lon, lat))
+	{
+		pos = std::make_pair(lon, lat);
+	}
+	else
+	{
+		pos = std::make_pair(cell.lon, cell.lat);
+	}
+	return true;
+}
+
+}
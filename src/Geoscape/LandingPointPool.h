@@ -0,0 +1,65 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstddef>
+#include <map>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace OpenXcom
+{
+
+class Globe;
+class RuleRegion;
+
+/**
+ * Keeps the points of mission zones where UFOs can land,
+ * so a landing point can be picked with a single draw
+ * instead of trying random points until one is on land.
+ * The points are the centers of a grid laid over each area,
+ * found the first time the zone is used.
+ */
+class LandingPointPool
+{
+private:
+	/// A grid cell with its center on valid ground.
+	struct Cell
+	{
+		double lon, lat, halfLon, halfLat;
+		/// Running total of the cell weights up to and including this one.
+		int weightSum;
+	};
+	/// The valid cells of a zone, by kind of ground.
+	struct Pool
+	{
+		std::vector<Cell> land, fakeWater;
+	};
+	std::map<std::tuple<const RuleRegion*, size_t, int>, Pool> _pools;
+
+	/// Gets the pool of a zone, building it if needed.
+	const Pool &getPool(const Globe &globe, const RuleRegion &region, size_t zone, int area);
+	/// Checks if a point is valid ground.
+	static bool isValid(const Globe &globe, const RuleRegion &region, int area, bool fakeWater, double lon, double lat);
+public:
+	/// Gets a random landing point in a mission zone.
+	bool getPoint(const Globe &globe, const RuleRegion &region, size_t zone, int area, bool fakeWater, std::pair<double, double> &pos);
+};
+
+}
@@ -310,6 +310,28 @@ MonthlyReportState::~MonthlyReportState()
 {
 }
 
+/**
+ * Counts the month of service of all soldiers
+ * and awards the commendations they earned.
+ */
+void MonthlyReportState::awardMonthlyService()
+{
+	// Iterate through all your bases
+	for (auto* xbase : *_game->getSavedGame()->getBases())
+	{
+		// Iterate through all your soldiers
+		for (auto* soldier : *xbase->getSoldiers())
+		{
+			// Award medals to eligible soldiers
+			soldier->getDiary()->addMonthlyService();
+			if (soldier->getDiary()->manageCommendations(_game->getMod(), _game->getSavedGame()->getMissionStatistics()))
+			{
+				_soldiersMedalled.push_back(soldier);
+			}
+		}
+	}
+}
+
 /**
  * Returns to the previous screen.
  * @param action Pointer to an action.
@@ -319,21 +341,7 @@ void MonthlyReportState::btnOkClick(Action *)
 	if (!_gameOver)
 	{
 		_game->popState();
-		// Award medals for service time
-		// Iterate through all your bases
-		for (auto* xbase : *_game->getSavedGame()->getBases())
-		{
-			// Iterate through all your soldiers
-			for (auto* soldier : *xbase->getSoldiers())
-			{
-				// Award medals to eligible soldiers
-				soldier->getDiary()->addMonthlyService();
-				if (soldier->getDiary()->manageCommendations(_game->getMod(), _game->getSavedGame()->getMissionStatistics()))
-				{
-					_soldiersMedalled.push_back(soldier);
-				}
-			}
-		}
+		awardMonthlyService();
 		if (!_soldiersMedalled.empty())
 		{
 			_game->pushState(new CommendationState(_soldiersMedalled));
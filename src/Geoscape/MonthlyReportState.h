@@ -59,6 +59,12 @@ public:
 	void btnOkClick(Action *action);
 	/// Calculate monthly scores.
 	void calculateChanges();
+	/// Awards medals for service time.
+	void awardMonthlyService();
+	/// Gets the total score of the month.
+	int getRating() const { return _ratingTotal; }
+	/// Did the month end the game?
+	bool isGameOver() const { return _gameOver != 0; }
 };
 
 }
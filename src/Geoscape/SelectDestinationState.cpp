@@ -158,7 +158,7 @@ SelectDestinationState::SelectDestinationState(std::vector<Craft*> crafts, Globe
 		}
 	}
 
-	if (_crafts.front()->getStatus() != "STR_OUT")
+	if (_crafts.front()->getStatusId() != CRAFT_OUT)
 	{
 		_globe->setCraftRange(_crafts.front()->getLongitude(), _crafts.front()->getLatitude(), _crafts.front()->getBaseRange());
 		_globe->invalidate();
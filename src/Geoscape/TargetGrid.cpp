@@ -0,0 +1,165 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "TargetGrid.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include "../fmath.h"
+#include "../Savegame/Target.h"
+
+namespace OpenXcom
+{
+
+namespace
+{
+
+/// Smallest cell size, one degree, so tiny ranges don't make huge grids.
+const double MinCellSize = M_PI / 180.0;
+
+}
+
+/**
+ * Creates an empty grid with one cell.
+ */
+TargetGrid::TargetGrid() : _cellSize(2 * M_PI), _rows(1), _cols(1)
+{
+}
+
+/**
+ * Removes all the targets and changes the size of the cells.
+ * Cells about as big as the range of the queries work best.
+ * @param cellSize Size of a cell in radians.
+ */
+void TargetGrid::reset(double cellSize)
+{
+	_cellSize = std::max(cellSize, MinCellSize);
+	_rows = (int)std::ceil(M_PI / _cellSize);
+	_cols = (int)std::ceil(2 * M_PI / _cellSize);
+	_cells.clear();
+}
+
+/**
+ * Gets the row a latitude falls in.
+ * @param lat Latitude in radians.
+ * @return Row index.
+ */
+int TargetGrid::getRow(double lat) const
+{
+	return Clamp((int)std::floor((lat + M_PI / 2) / _cellSize), 0, _rows - 1);
+}
+
+/**
+ * Gets the column a longitude falls in.
+ * @param lon Longitude in radians, any turn.
+ * @return Column index.
+ */
+int TargetGrid::getCol(double lon) const
+{
+	lon = std::fmod(lon, 2 * M_PI);
+	if (lon < 0)
+	{
+		lon += 2 * M_PI;
+	}
+	return Clamp((int)std::floor(lon / _cellSize), 0, _cols - 1);
+}
+
+/**
+ * Adds a target to the cell of its current position.
+ * Call finish() once all the targets are in.
+ * @param target Pointer to the target.
+ */
+void TargetGrid::insert(const Target *target)
+{
+	int cell = getRow(target->getLatitude()) * _cols + getCol(target->getLongitude());
+	_cells.push_back(std::make_pair(cell, (int)_cells.size()));
+}
+
+/**
+ * Sorts the targets by cell, so queries can find them.
+ */
+void TargetGrid::finish()
+{
+	std::sort(_cells.begin(), _cells.end());
+}
+
+/**
+ * Adds the targets in a span of cells of a row to the results.
+ * @param row Row index.
+ * @param firstCol First column index.
+ * @param lastCol Last column index, inclusive.
+ * @param result List of target indices to add to.
+ */
+void TargetGrid::addCells(int row, int firstCol, int lastCol, std::vector<int> &result) const
+{
+	auto i = std::lower_bound(_cells.begin(), _cells.end(), std::make_pair(row * _cols + firstCol, INT_MIN));
+	for (int last = row * _cols + lastCol; i != _cells.end() && i->first <= last; ++i)
+	{
+		result.push_back(i->second);
+	}
+}
+
+/**
+ * Gets all the targets that might be within a distance of a point.
+ * Every target that really is in range is returned, along with
+ * some that aren't, so callers still need to check the distance.
+ * @param lon Longitude of the point in radians.
+ * @param lat Latitude of the point in radians.
+ * @param range Distance in radians.
+ * @param result List to fill with target indices, in the order they were added.
+ */
+void TargetGrid::query(double lon, double lat, double range, std::vector<int> &result) const
+{
+	result.clear();
+	int firstRow = getRow(lat - range);
+	int lastRow = getRow(lat + range);
+
+	// the widest longitude of a circle on the sphere, unless it covers a pole
+	bool allCols = lat + range >= M_PI / 2 || lat - range <= -M_PI / 2 || std::sin(range) >= std::cos(lat);
+	int firstCol = 0, lastCol = _cols - 1;
+	if (!allCols)
+	{
+		double halfWidth = std::asin(std::sin(range) / std::cos(lat));
+		if (2 * (halfWidth + _cellSize) >= 2 * M_PI)
+		{
+			allCols = true;
+		}
+		else
+		{
+			firstCol = getCol(lon - halfWidth);
+			lastCol = getCol(lon + halfWidth);
+		}
+	}
+
+	for (int row = firstRow; row <= lastRow; ++row)
+	{
+		if (allCols || firstCol <= lastCol)
+		{
+			addCells(row, allCols ? 0 : firstCol, allCols ? _cols - 1 : lastCol, result);
+		}
+		else
+		{
+			// wraps around the date line
+			addCells(row, firstCol, _cols - 1, result);
+			addCells(row, 0, lastCol, result);
+		}
+	}
+	std::sort(result.begin(), result.end());
+}
+
+}
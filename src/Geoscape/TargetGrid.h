@@ -0,0 +1,62 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <vector>
+#include <utility>
+
+namespace OpenXcom
+{
+
+class Target;
+
+/**
+ * Buckets targets on the globe into cells of latitude and longitude,
+ * so range checks only have to look at the targets in nearby cells.
+ * Targets are identified by the order they were added in.
+ */
+class TargetGrid
+{
+private:
+	double _cellSize;
+	int _rows, _cols;
+	/// Cell of each target, paired with the target index and sorted.
+	std::vector<std::pair<int, int> > _cells;
+
+	/// Gets the row of a latitude.
+	int getRow(double lat) const;
+	/// Gets the column of a longitude.
+	int getCol(double lon) const;
+	/// Adds the targets of a range of cells in a row.
+	void addCells(int row, int firstCol, int lastCol, std::vector<int> &result) const;
+public:
+	/// Creates an empty grid.
+	TargetGrid();
+	/// Empties the grid and sets the size of its cells.
+	void reset(double cellSize);
+	/// Adds a target to the grid.
+	void insert(const Target *target);
+	/// Sorts the grid after adding targets.
+	void finish();
+	/// Gets the targets that can be within a distance of a point.
+	void query(double lon, double lat, double range, std::vector<int> &result) const;
+	/// Gets the number of targets in the grid.
+	int size() const { return (int)_cells.size(); }
+};
+
+}
@@ -17,6 +17,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "Text.h"
+#include <unordered_map>
 #include "../fmath.h"
 #include "../Engine/Font.h"
 #include "../Engine/Options.h"
@@ -29,6 +30,58 @@
 namespace OpenXcom
 {
 
+namespace
+{
+
+/**
+ * Everything that affects the result of text layout.
+ * Parameters that only matter for wordwrap are zeroed when wrap is disabled, to share more entries.
+ */
+struct TextLayoutKey
+{
+	const Font *font;
+	const Font *small;
+	std::string text;
+	int width;
+	TextWrapping wrapping;
+	bool wrap, indent, ignoreSeparators;
+
+	bool operator==(const TextLayoutKey& other) const
+	{
+		return font == other.font
+			&& small == other.small
+			&& width == other.width
+			&& wrapping == other.wrapping
+			&& wrap == other.wrap
+			&& indent == other.indent
+			&& ignoreSeparators == other.ignoreSeparators
+			&& text == other.text;
+	}
+};
+
+struct TextLayoutKeyHash
+{
+	size_t operator()(const TextLayoutKey& key) const
+	{
+		size_t h = std::hash<std::string>()(key.text);
+		h ^= std::hash<const void*>()(key.font) + 0x9e3779b9 + (h << 6) + (h >> 2);
+		h ^= std::hash<const void*>()(key.small) + 0x9e3779b9 + (h << 6) + (h >> 2);
+		h ^= std::hash<int>()(key.width * 16 + key.wrapping * 8 + key.wrap * 4 + key.indent * 2 + key.ignoreSeparators) + 0x9e3779b9 + (h << 6) + (h >> 2);
+		return h;
+	}
+};
+
+/// Max number of cached layouts, when reached whole cache is dropped.
+const size_t TextLayoutCacheLimit = 8192;
+
+/// Layouts shared by all texts.
+std::unordered_map<TextLayoutKey, std::shared_ptr<const TextLayout>, TextLayoutKeyHash> textLayoutCache;
+
+/// Layout used by texts that was not processed yet.
+const std::shared_ptr<const TextLayout> emptyTextLayout = std::make_shared<const TextLayout>();
+
+} //namespace
+
 /**
  * Sets up a blank text with the specified size and position.
  * @param width Width in pixels.
@@ -37,7 +90,7 @@ namespace OpenXcom
  * @param y Y position in pixels.
  */
 Text::Text(int width, int height, int x, int y) : InteractiveSurface(width, height, x, y),
-	_big(0), _small(0), _font(0), _fontOrig(0), _lang(0),
+	_big(0), _small(0), _font(0), _fontOrig(0), _lang(0), _layout(emptyTextLayout),
 	_wrap(false), _invert(false), _contrast(false), _indent(false), _scroll(false), _ignoreSeparators(false),
 	_align(ALIGN_LEFT), _valign(ALIGN_TOP), _color(0), _color2(0), _scrollY(0)
 {
@@ -254,7 +307,7 @@ Uint8 Text::getSecondaryColor() const
 
 int Text::getNumLines() const
 {
-	return _wrap ? _lineHeight.size() : 1;
+	return _wrap ? _layout->lineHeight.size() : 1;
 }
 
 /**
@@ -267,7 +320,7 @@ int Text::getTextHeight(int line) const
 	if (line == -1)
 	{
 		int height = 0;
-		for (int lh : _lineHeight)
+		for (int lh : _layout->lineHeight)
 		{
 			height += lh;
 		}
@@ -275,7 +328,7 @@ int Text::getTextHeight(int line) const
 	}
 	else
 	{
-		return _lineHeight[line];
+		return _layout->lineHeight[line];
 	}
 }
 
@@ -289,7 +342,7 @@ int Text::getTextWidth(int line) const
 	if (line == -1)
 	{
 		int width = 0;
-		for (int lw : _lineWidth)
+		for (int lw : _layout->lineWidth)
 		{
 			if (lw > width)
 			{
@@ -300,7 +353,7 @@ int Text::getTextWidth(int line) const
 	}
 	else
 	{
-		return _lineWidth[line];
+		return _layout->lineWidth[line];
 	}
 }
 
@@ -308,6 +361,8 @@ int Text::getTextWidth(int line) const
  * Takes care of any text post-processing like converting
  * encoded text to individual codepoints and calculating
  * line metrics for alignment and wordwrapping.
+ * Results are shared through global layout cache, so texts
+ * with same string and settings are processed only once.
  */
 void Text::processText()
 {
@@ -316,16 +371,50 @@ void Text::processText()
 		return;
 	}
 
-	_processedText = Unicode::convUtf8ToUtf32(_text);
-	_lineWidth.clear();
-	_lineHeight.clear();
 	_scrollY = 0;
+	_redraw = true;
+
+	TextLayoutKey key = { _font, _small, _text, 0, WRAP_AUTO, _wrap, false, false };
+	if (_wrap)
+	{
+		key.width = getWidth();
+		key.wrapping = _lang->getTextWrapping();
+		key.indent = _indent;
+		key.ignoreSeparators = _ignoreSeparators;
+	}
+
+	auto it = textLayoutCache.find(key);
+	if (it != textLayoutCache.end())
+	{
+		_layout = it->second;
+		return;
+	}
+
+	_layout = layoutText();
+	if (textLayoutCache.size() >= TextLayoutCacheLimit)
+	{
+		textLayoutCache.clear();
+	}
+	textLayoutCache.emplace(std::move(key), _layout);
+}
+
+/**
+ * Calculates line breaks and line metrics of the contained text
+ * by walking it character by character.
+ * @return New layout.
+ */
+std::shared_ptr<const TextLayout> Text::layoutText() const
+{
+	auto layout = std::make_shared<TextLayout>();
+	layout->text = Unicode::convUtf8ToUtf32(_text);
 
 	int width = 0, word = 0;
 	size_t space = 0, textIndentation = 0;
 	bool start = true;
 	Font *font = _font;
-	UString &str = _processedText;
+	UString &str = layout->text;
+	std::vector<int> &lineWidth = layout->lineWidth;
+	std::vector<int> &lineHeight = layout->lineHeight;
 
 	// Go through the text character by character
 	for (size_t c = 0; c <= str.size(); ++c)
@@ -334,8 +423,8 @@ void Text::processText()
 		if (c == str.size() || Unicode::isLinebreak(str[c]))
 		{
 			// Add line measurements for alignment later
-			_lineWidth.push_back(width);
-			_lineHeight.push_back(font->getCharSize('\n').h);
+			lineWidth.push_back(width);
+			lineHeight.push_back(font->getCharSize('\n').h);
 			width = 0;
 			word = 0;
 			start = true;
@@ -406,8 +495,8 @@ void Text::processText()
 					width += font->getCharSize('\t').w;
 				}
 
-				_lineWidth.push_back(width);
-				_lineHeight.push_back(font->getCharSize('\n').h);
+				lineWidth.push_back(width);
+				lineHeight.push_back(font->getCharSize('\n').h);
 				if (_lang->getTextWrapping() == WRAP_WORDS)
 				{
 					width = word;
@@ -421,7 +510,7 @@ void Text::processText()
 		}
 	}
 
-	_redraw = true;
+	return layout;
 }
 
 namespace
@@ -457,10 +546,10 @@ int Text::getLineX(int line) const
 		case ALIGN_LEFT:
 			break;
 		case ALIGN_CENTER:
-			x = (int)ceil((getWidth() + _font->getSpacing() - _lineWidth[line]) / 2.0);
+			x = (int)ceil((getWidth() + _font->getSpacing() - _layout->lineWidth[line]) / 2.0);
 			break;
 		case ALIGN_RIGHT:
-			x = getWidth() - 1 - _lineWidth[line];
+			x = getWidth() - 1 - _layout->lineWidth[line];
 			break;
 		}
 		break;
@@ -471,10 +560,10 @@ int Text::getLineX(int line) const
 			x = getWidth() - 1;
 			break;
 		case ALIGN_CENTER:
-			x = getWidth() - (int)ceil((getWidth() + _font->getSpacing() - _lineWidth[line]) / 2.0);
+			x = getWidth() - (int)ceil((getWidth() + _font->getSpacing() - _layout->lineWidth[line]) / 2.0);
 			break;
 		case ALIGN_RIGHT:
-			x = _lineWidth[line];
+			x = _layout->lineWidth[line];
 			break;
 		}
 		break;
@@ -513,7 +602,7 @@ void Text::draw()
 	int x = 0, y = 0, line = 0, height = 0;
 	Font *font = _font;
 	int color = _color;
-	const UString &s = _processedText;
+	const UString &s = _layout->text;
 
 	height = getTextHeight();
 
@@ -624,4 +713,13 @@ void Text::mousePress(Action* action, State* state)
 	}
 }
 
+/**
+ * Drops all cached text layouts. Need to be called when any font is destroyed,
+ * as cache entries are keyed by font pointers.
+ */
+void Text::clearLayoutCache()
+{
+	textLayoutCache.clear();
+}
+
 }
@@ -20,6 +20,7 @@
 #include "../Engine/InteractiveSurface.h"
 #include <vector>
 #include <string>
+#include <memory>
 #include "../Engine/Unicode.h"
 
 namespace OpenXcom
@@ -31,6 +32,16 @@ class Language;
 enum TextHAlign { ALIGN_LEFT, ALIGN_CENTER, ALIGN_RIGHT };
 enum TextVAlign { ALIGN_TOP, ALIGN_MIDDLE, ALIGN_BOTTOM };
 
+/**
+ * Result of text layout, codepoints with linebreaks inserted by wordwrap and metrics of each line.
+ * Shared between all texts with same string, fonts and wrap settings.
+ */
+struct TextLayout
+{
+	UString text;
+	std::vector<int> lineWidth, lineHeight;
+};
+
 /**
  * Text string displayed on screen.
  * Takes the characters from a Font and puts them together on screen
@@ -43,8 +54,7 @@ private:
 	Font *_big, *_small, *_font, *_fontOrig;
 	Language *_lang;
 	std::string _text;
-	UString _processedText;
-	std::vector<int> _lineWidth, _lineHeight;
+	std::shared_ptr<const TextLayout> _layout;
 	bool _wrap, _invert, _contrast, _indent, _scroll, _ignoreSeparators;
 	TextHAlign _align;
 	TextVAlign _valign;
@@ -53,6 +63,8 @@ private:
 
 	/// Processes the contained text.
 	void processText();
+	/// Calculates layout of the contained text.
+	std::shared_ptr<const TextLayout> layoutText() const;
 	/// Gets the X position of a text line.
 	int getLineX(int line) const;
 public:
@@ -106,6 +118,8 @@ public:
 	void setScrollable(bool scroll);
 	/// Special handling for mouse presses.
 	void mousePress(Action* action, State* state) override;
+	/// Drops all cached text layouts.
+	static void clearLayoutCache();
 };
 
 }
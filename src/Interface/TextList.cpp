@@ -44,7 +44,8 @@ TextList::TextList(int width, int height, int x, int y) : InteractiveSurface(wid
 	_dot(false), _selectable(false), _condensed(false), _contrast(false), _wrap(false), _flooding(false), _ignoreSeparators(false),
 	_bg(0), _selector(0), _margin(0), _scrolling(true), _arrowPos(-1), _scrollPos(4), _arrowType(ARROW_VERTICAL),
 	_leftClick(0), _leftPress(0), _leftRelease(0), _rightClick(0), _rightPress(0), _rightRelease(0),
-	_arrowsLeftEdge(0), _arrowsRightEdge(0), _noScrollLeftEdge(0), _noScrollRightEdge(0), _comboBox(0)
+	_arrowsLeftEdge(0), _arrowsRightEdge(0), _noScrollLeftEdge(0), _noScrollRightEdge(0), _comboBox(0),
+	_providerState(0), _provider(0)
 {
 	_up = new ArrowButton(ARROW_BIG_UP, 13, 14, getX() + getWidth() + _scrollPos, getY());
 	_up->setVisible(false);
@@ -155,6 +156,12 @@ void TextList::unpress(State *state)
  */
 void TextList::setCellColor(size_t row, size_t column, Uint8 color)
 {
+	if (_provider != 0)
+	{
+		// remember it, the row can be dropped and provided again later
+		_providedColors[std::make_pair(row, column)] = color;
+	}
+	provideRow(row);
 	_texts[row][column]->setColor(color);
 	_redraw = true;
 }
@@ -166,6 +173,14 @@ void TextList::setCellColor(size_t row, size_t column, Uint8 color)
  */
 void TextList::setRowColor(size_t row, Uint8 color)
 {
+	if (_provider != 0)
+	{
+		for (size_t column = 0; column < _columns.size(); ++column)
+		{
+			_providedColors[std::make_pair(row, column)] = color;
+		}
+	}
+	provideRow(row);
 	for (auto* text : _texts[row])
 	{
 		text->setColor(color);
@@ -181,6 +196,11 @@ void TextList::setRowColor(size_t row, Uint8 color)
  */
 std::string TextList::getCellText(size_t row, size_t column) const
 {
+	if (_texts[row].empty())
+	{
+		// row not materialized by data-provider, materializing is only a cache of provider data
+		const_cast<TextList*>(this)->provideRow(row);
+	}
 	return _texts[row][column]->getText();
 }
 
@@ -192,6 +212,12 @@ std::string TextList::getCellText(size_t row, size_t column) const
  */
 void TextList::setCellText(size_t row, size_t column, const std::string &text)
 {
+	if (_provider != 0)
+	{
+		// remember it, the row can be dropped and provided again later
+		_providedTexts[std::make_pair(row, column)] = text;
+	}
+	provideRow(row);
 	_texts[row][column]->setText(text);
 	_redraw = true;
 }
@@ -203,6 +229,16 @@ void TextList::setCellText(size_t row, size_t column, const std::string &text)
  */
 int TextList::getColumnX(size_t column) const
 {
+	if (_texts[0].empty())
+	{
+		// row not materialized by data-provider
+		int x = _margin;
+		for (size_t i = 0; i < column; ++i)
+		{
+			x += _columns[i];
+		}
+		return getX() + x;
+	}
 	return getX() + _texts[0][column]->getX();
 }
 
@@ -213,6 +249,11 @@ int TextList::getColumnX(size_t column) const
  */
 int TextList::getRowY(size_t row) const
 {
+	if (_texts[row].empty())
+	{
+		// row not materialized by data-provider
+		return getY() + ((int)row - (int)_scroll) * (_font->getHeight() + _font->getSpacing());
+	}
 	return getY() + _texts[row][0]->getY();
 }
 
@@ -223,6 +264,11 @@ int TextList::getRowY(size_t row) const
  */
 int TextList::getTextHeight(size_t row) const
 {
+	if (_texts[row].empty())
+	{
+		// row not materialized by data-provider
+		return _font->getHeight();
+	}
 	return _texts[row].front()->getTextHeight();
 }
 
@@ -233,6 +279,11 @@ int TextList::getTextHeight(size_t row) const
  */
 int TextList::getNumTextLines(size_t row) const
 {
+	if (_texts[row].empty())
+	{
+		// row not materialized by data-provider
+		return 1;
+	}
 	return _texts[row].front()->getNumLines();
 }
 
@@ -272,6 +323,64 @@ size_t TextList::getVisibleRows() const
 	return _visibleRows;
 }
 
+/**
+ * Creates a new cell of the list, using the current
+ * colors, alignment and font of the list.
+ * @param col Column number.
+ * @param width Width of the cell in pixels.
+ * @param x X position relative to the list.
+ * @param y Y position relative to the list.
+ * @return New text.
+ */
+Text *TextList::createCell(size_t col, int width, int x, int y)
+{
+	Text* txt = new Text(width, _font->getHeight(), x, y);
+	txt->setPalette(this->getPalette());
+	txt->initText(_big, _small, _lang);
+	txt->setColor(_color);
+	txt->setSecondaryColor(_color2);
+	if (_align[col])
+	{
+		txt->setAlign(_align[col]);
+	}
+	txt->setHighContrast(_contrast);
+	if (_font == _big)
+	{
+		txt->setBig();
+	}
+	else
+	{
+		txt->setSmall();
+	}
+	return txt;
+}
+
+/**
+ * Fills the empty space of a cell with dots,
+ * to separate it from the next column.
+ * @param txt Cell text.
+ * @param col Column number.
+ */
+void TextList::addDots(Text *txt, size_t col)
+{
+	std::string buf = txt->getText();
+	unsigned int w = txt->getTextWidth();
+	while (w < _columns[col])
+	{
+		if (_align[col] != ALIGN_RIGHT)
+		{
+			w += _font->getChar('.').getCrop()->w + _font->getSpacing();
+			buf += '.';
+		}
+		if (_align[col] != ALIGN_LEFT)
+		{
+			w += _font->getChar('.').getCrop()->w + _font->getSpacing();
+			buf.insert(0, 1, '.');
+		}
+	}
+	txt->setText(buf);
+}
+
 /**
  * Adds a new row of text to the list, automatically creating
  * the required Text objects lined up where they need to be.
@@ -297,7 +406,15 @@ void TextList::addRow(int cols, ...)
 	int rowX = 0, rowY = 0, rows = 1, rowHeight = 0;
 	if (!_texts.empty())
 	{
-		rowY = _texts.back().front()->getY() + _texts.back().front()->getHeight() + _font->getSpacing();
+		if (_texts.back().empty())
+		{
+			// last row not materialized by data-provider, it is always one line high
+			rowY = ((int)_texts.size() - (int)_scroll) * (_font->getHeight() + _font->getSpacing());
+		}
+		else
+		{
+			rowY = _texts.back().front()->getY() + _texts.back().front()->getHeight() + _font->getSpacing();
+		}
 	}
 
 	for (int i = 0; i < ncols; ++i)
@@ -312,24 +429,7 @@ void TextList::addRow(int cols, ...)
 		{
 			width = _columns[i];
 		}
-		Text* txt = new Text(width, _font->getHeight(), _margin + rowX, rowY);
-		txt->setPalette(this->getPalette());
-		txt->initText(_big, _small, _lang);
-		txt->setColor(_color);
-		txt->setSecondaryColor(_color2);
-		if (_align[i])
-		{
-			txt->setAlign(_align[i]);
-		}
-		txt->setHighContrast(_contrast);
-		if (_font == _big)
-		{
-			txt->setBig();
-		}
-		else
-		{
-			txt->setSmall();
-		}
+		Text* txt = createCell(i, width, _margin + rowX, rowY);
 		if (cols > 0)
 			txt->setText(va_arg(args, char*));
 		// grab this before we enable word wrapping so we can use it to calculate
@@ -346,22 +446,7 @@ void TextList::addRow(int cols, ...)
 		// Places dots between text
 		if (_dot && i < cols - 1)
 		{
-			std::string buf = txt->getText();
-			unsigned int w = txt->getTextWidth();
-			while (w < _columns[i])
-			{
-				if (_align[i] != ALIGN_RIGHT)
-				{
-					w += _font->getChar('.').getCrop()->w + _font->getSpacing();
-					buf += '.';
-				}
-				if (_align[i] != ALIGN_LEFT)
-				{
-					w += _font->getChar('.').getCrop()->w + _font->getSpacing();
-					buf.insert(0, 1, '.');
-				}
-			}
-			txt->setText(buf);
+			addDots(txt, i);
 		}
 
 		temp.push_back(txt);
@@ -432,6 +517,8 @@ void TextList::removeLastRow()
 {
 	if (!_texts.empty())
 	{
+		const size_t last = _texts.size() - 1;
+		_providedRows.erase(std::remove(_providedRows.begin(), _providedRows.end(), last), _providedRows.end());
 		_texts.pop_back();
 	}
 	if (!_rows.empty())
@@ -457,6 +544,134 @@ void TextList::removeLastRow()
 	updateArrows();
 }
 
+/**
+ * Switches the list to data-provider mode. Instead of storing every row,
+ * the list only asks the provider to fill the rows currently in the scroll
+ * window (plus a few around it) and drops the rest.
+ * Arrow columns and word wrap are not supported in this mode,
+ * each row is always exactly one line high.
+ * Cell colors and texts set later are remembered and reapplied when
+ * a row is provided again, rows added by `addRow` are stored as usual.
+ * @param state State owning the provider.
+ * @param provider Handler filling the cells of a given row.
+ * @param rows Number of rows in the list.
+ */
+void TextList::setRowProvider(State *state, TextListRowProvider provider, size_t rows)
+{
+	clearList();
+	_providerState = state;
+	_provider = provider;
+	_texts.resize(rows);
+	_rows.reserve(rows);
+	for (size_t i = 0; i < rows; ++i)
+	{
+		_rows.push_back(i);
+	}
+	_redraw = true;
+	updateArrows();
+}
+
+/**
+ * Drops all rows materialized in data-provider mode,
+ * e.g. when data behind them changed.
+ * Colors and texts set on rows by callers are kept.
+ */
+void TextList::invalidateRows()
+{
+	for (size_t row : _providedRows)
+	{
+		for (auto* text : _texts[row])
+		{
+			delete text;
+		}
+		_texts[row].clear();
+	}
+	_providedRows.clear();
+	_redraw = true;
+}
+
+/**
+ * Creates the texts of a row in data-provider mode
+ * and lets the provider fill them.
+ * @param row Row number.
+ */
+void TextList::provideRow(size_t row)
+{
+	if (_provider == 0 || !_texts[row].empty())
+	{
+		return;
+	}
+
+	auto& cells = _texts[row];
+	const int cols = _columns.size();
+	const int rowY = ((int)row - (int)_scroll) * (_font->getHeight() + _font->getSpacing());
+	int rowX = 0;
+	for (int i = 0; i < cols; ++i)
+	{
+		cells.push_back(createCell(i, _flooding ? 340 : _columns[i], _margin + rowX, rowY));
+		rowX += _columns[i];
+	}
+
+	(_providerState->*_provider)(row, cells);
+
+	// reapply edits done by callers on previous materializations of this row
+	for (int i = 0; i < cols; ++i)
+	{
+		const auto key = std::make_pair(row, (size_t)i);
+		auto color = _providedColors.find(key);
+		if (color != _providedColors.end())
+		{
+			cells[i]->setColor(color->second);
+		}
+		auto text = _providedTexts.find(key);
+		if (text != _providedTexts.end())
+		{
+			cells[i]->setText(text->second);
+		}
+	}
+
+	rowX = 0;
+	for (int i = 0; i < cols; ++i)
+	{
+		if (_dot && i < cols - 1)
+		{
+			addDots(cells[i], i);
+		}
+		if (_condensed)
+		{
+			cells[i]->setX(_margin + rowX);
+			rowX += cells[i]->getTextWidth();
+		}
+	}
+	_providedRows.push_back(row);
+}
+
+/**
+ * Drops rows materialized in data-provider mode that are
+ * further than one page away from the scroll window.
+ */
+void TextList::trimProvidedRows()
+{
+	const size_t begin = _scroll > _visibleRows ? _scroll - _visibleRows : 0;
+	const size_t end = _scroll + 2 * _visibleRows;
+	auto it = std::remove_if(_providedRows.begin(), _providedRows.end(),
+		[&](size_t row)
+		{
+			if (row >= begin && row < end)
+			{
+				return false;
+			}
+			for (auto* text : _texts[row])
+			{
+				delete text;
+			}
+			_texts[row].clear();
+			return true;
+		}
+	);
+	_providedRows.erase(it, _providedRows.end());
+}
+
 /**
  * Changes the columns that the list contains.
  * While rows can be unlimited, columns need to be specified
@@ -894,6 +1109,11 @@ void TextList::clearList()
 	scrollUp(true, false);
 	_texts.clear();
 	_rows.clear();
+	_providedRows.clear();
+	_providedColors.clear();
+	_providedTexts.clear();
+	_providerState = 0;
+	_provider = 0;
 	_redraw = true;
 }
 
@@ -1016,6 +1236,7 @@ void TextList::draw()
 		}
 		for (size_t i = _rows[_scroll]; i < _texts.size() && i < _rows[_scroll] + _visibleRows; ++i)
 		{
+			provideRow(i);
 			for (auto* text : _texts[i])
 			{
 				text->setY(y);
@@ -1030,6 +1251,10 @@ void TextList::draw()
 				y += _font->getHeight() + _font->getSpacing();
 			}
 		}
+		if (_provider != 0)
+		{
+			trimProvidedRows();
+		}
 	}
 }
 
@@ -1229,6 +1454,7 @@ void TextList::mouseOver(Action *action, State *state)
 		_selRow = std::max(0, (int)(_scroll + (int)floor(action->getRelativeYMouse() / (rowHeight * action->getYScale()))));
 		if (_selRow < _rows.size())
 		{
+			provideRow(_rows[_selRow]);
 			Text *selText = _texts[_rows[_selRow]].front();
 			int y = getY() + selText->getY();
 			int actualHeight = selText->getHeight() + _font->getSpacing(); //current line height
@@ -31,6 +31,9 @@ class ArrowButton;
 class ComboBox;
 class ScrollBar;
 
+/// Fills cells of a single row of text list in data-provider mode.
+typedef void (State::* TextListRowProvider)(size_t row, std::vector<Text*> &cells);
+
 /**
  * List of Text's split into columns.
  * Contains a set of Text's that are automatically lined up by
@@ -60,11 +63,24 @@ private:
 	int _arrowsLeftEdge, _arrowsRightEdge;
 	int _noScrollLeftEdge, _noScrollRightEdge;
 	ComboBox *_comboBox;
+	State *_providerState;
+	TextListRowProvider _provider;
+	std::vector<size_t> _providedRows;
+	std::map<std::pair<size_t, size_t>, Uint8> _providedColors;
+	std::map<std::pair<size_t, size_t>, std::string> _providedTexts;
 
 	/// Updates the arrow buttons.
 	void updateArrows();
 	/// Updates the visible rows.
 	void updateVisible();
+	/// Creates a new cell with the current list settings.
+	Text *createCell(size_t col, int width, int x, int y);
+	/// Fills the rest of a cell with dots.
+	void addDots(Text *txt, size_t col);
+	/// Materializes a row in data-provider mode.
+	void provideRow(size_t row);
+	/// Drops materialized rows far away from the scroll window.
+	void trimProvidedRows();
 public:
 	/// Creates a text list with the specified size and position.
 	TextList(int width, int height, int x = 0, int y = 0);
@@ -108,6 +124,10 @@ public:
 	void addRow(int cols, ...);
 	/// Removes the last row from the text list.
 	void removeLastRow();
+	/// Switches the list to data-provider mode.
+	void setRowProvider(State *state, TextListRowProvider provider, size_t rows);
+	/// Drops all materialized rows, they will be requested again from the provider.
+	void invalidateRows();
 	/// Sets the columns in the text list.
 	void setColumns(int cols, ...);
 	/// Sets the palette of the text list.
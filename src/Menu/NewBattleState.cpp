@@ -350,7 +350,7 @@ void NewBattleState::load(const std::string &filename)
 			if (doc["base"])
 			{
 				const Mod *mod = _game->getMod();
-				SavedGame *save = new SavedGame();
+				SavedGame *save = new SavedGame(mod);
 
 				Base *base = new Base(mod);
 				base->load(doc["base"], save, false);
@@ -363,7 +363,7 @@ void NewBattleState::load(const std::string &filename)
 				}
 
 				// Generate items
-				base->getStorageItems()->getContents()->clear();
+				base->getStorageItems()->clear();
 				for (auto& itemType : mod->getItemsList())
 				{
 					RuleItem *rule = _game->getMod()->getItem(itemType);
@@ -377,20 +377,13 @@ void NewBattleState::load(const std::string &filename)
 				if (base->getCrafts()->empty())
 				{
 					std::string craftType = _crafts[_cbxCraft->getSelected()];
-					_craft = new Craft(_game->getMod()->getCraft(craftType), base, save->getId(craftType));
+					_craft = new Craft(_game->getMod()->getCraft(craftType), _game->getMod(), base, save->getId(craftType));
 					base->getCrafts()->push_back(_craft);
 				}
 				else
 				{
+					// unknown items were already dropped when loading the craft
 					_craft = base->getCrafts()->front();
-					for (auto& pair : *_craft->getItems()->getContents())
-					{
-						RuleItem *rule = _game->getMod()->getItem(pair.first);
-						if (!rule)
-						{
-							pair.second = 0;
-						}
-					}
 				}
 
 				_game->setSavedGame(save);
@@ -441,7 +434,7 @@ void NewBattleState::save(const std::string &filename)
 void NewBattleState::initSave()
 {
 	const Mod *mod = _game->getMod();
-	SavedGame *save = new SavedGame();
+	SavedGame *save = new SavedGame(mod);
 	Base *base = new Base(mod);
 	const YAML::Node &starter = _game->getMod()->getDefaultStartingBase();
 	base->load(starter, save, true, true);
@@ -458,9 +451,9 @@ void NewBattleState::initSave()
 		delete xcraft;
 	}
 	base->getCrafts()->clear();
-	base->getStorageItems()->getContents()->clear();
+	base->getStorageItems()->clear();
 
-	_craft = new Craft(mod->getCraft(_crafts[_cbxCraft->getSelected()]), base, 1);
+	_craft = new Craft(mod->getCraft(_crafts[_cbxCraft->getSelected()]), mod, base, 1);
 	base->getCrafts()->push_back(_craft);
 
 	// Generate soldiers
@@ -731,7 +724,7 @@ void NewBattleState::cbxCraftChange(Action *)
 	_craft->changeRules(_game->getMod()->getCraft(_crafts[_cbxCraft->getSelected()]));
 
 	int count = 0;
-	Craft* tmpCraft = new Craft(_craft->getRules(), _craft->getBase(), 0);
+	Craft* tmpCraft = new Craft(_craft->getRules(), _game->getMod(), _craft->getBase(), 0);
 
 	// temporarily re-assign all soldiers to a dummy craft
 	for (auto* soldier : *_craft->getBase()->getSoldiers())
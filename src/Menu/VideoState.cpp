@@ -19,7 +19,6 @@
 #include "VideoState.h"
 #include <algorithm>
 #include <SDL_mixer.h>
-#include "../Engine/Adlib/adlplayer.h"
 #include "../Engine/Logger.h"
 #include "../Engine/Game.h"
 #include "../Engine/Options.h"
@@ -28,6 +27,7 @@
 #include "../Engine/FileMap.h"
 #include "../Engine/Screen.h"
 #include "../Engine/Music.h"
+#include "../Engine/AdlibMusic.h"
 #include "../Engine/Sound.h"
 #include "../Mod/Mod.h"
 #include "../Mod/RuleVideo.h"
@@ -492,7 +492,7 @@ void VideoState::init()
 		if (Mix_GetMusicType(0) != MUS_MID)
 		{
 			Mix_FadeOutMusic(FADE_DELAY * FADE_STEPS);
-			func_fade();
+			AdlibMusic::fade(FADE_DELAY * FADE_STEPS);
 		}
 		else
 		{
@@ -168,6 +168,42 @@ bool ExtraSprites::isImageFile(const std::string &filename)
 	return false;
 }
 
+/**
+ * Gets the image files the sprite is loaded from,
+ * in the order loadSurface() or loadSurfaceSet() loads them.
+ * @param files List to add the file names to.
+ */
+void ExtraSprites::getImageFiles(std::vector<std::string> &files) const
+{
+	if (_loaded || _sprites.empty())
+		return;
+
+	if (_singleImage)
+	{
+		files.push_back(_sprites.begin()->second);
+		return;
+	}
+	for (const auto& pair : _sprites)
+	{
+		const auto& fileName = pair.second;
+		if (fileName[fileName.length() - 1] == '/')
+		{
+			std::vector<std::string> contents;
+			for (const auto& f: FileMap::getVFolderContents(fileName)) { contents.push_back(f); }
+			std::sort(contents.begin(), contents.end(), Unicode::naturalCompare);
+			for (const auto& name : contents)
+			{
+				if (isImageFile(name))
+					files.push_back(fileName + name);
+			}
+		}
+		else
+		{
+			files.push_back(fileName);
+		}
+	}
+}
+
 /**
  * Loads the external sprite into a new or existing surface.
  * @param surface Existing surface.
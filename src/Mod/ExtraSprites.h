@@ -19,6 +19,7 @@
  */
 #include <yaml-cpp/yaml.h>
 #include <string>
+#include <vector>
 #include <map>
 
 namespace OpenXcom
@@ -68,6 +69,8 @@ public:
 	bool isLoaded() const;
 	/// Checks if a filename is a valid image file.
 	static bool isImageFile(const std::string &filename);
+	/// Gets the image files the sprite is loaded from.
+	void getImageFiles(std::vector<std::string> &files) const;
 	/// Load the external sprite into a surface.
 	Surface *loadSurface(Surface *surface);
 	/// Load the external sprite into a surface set.
@@ -18,9 +18,11 @@
  */
 #include <sstream>
 #include <algorithm>
+#include <iterator>
 #include "MapBlock.h"
 #include "../Battlescape/Position.h"
 #include "../Engine/Exception.h"
+#include "../Engine/FileMap.h"
 
 namespace YAML
 {
@@ -57,7 +59,7 @@ namespace OpenXcom
 /**
  * MapBlock construction.
  */
-MapBlock::MapBlock(const std::string &name): _name(name), _size_x(10), _size_y(10), _size_z(4)
+MapBlock::MapBlock(const std::string &name): _name(name), _size_x(10), _size_y(10), _size_z(4), _mapFileLoaded(false), _routeFileLoaded(false)
 {
 	_groups.push_back(0);
 }
@@ -203,4 +205,38 @@ const std::map<std::string, std::pair<int, int> > *MapBlock::getItemsFuseTimers(
 	return &_itemsFuseTimer;
 }
 
+/**
+ * Gets the raw contents of the MAP file of this block.
+ * The file is only read the first time, every mission
+ * using the block after that gets the same data.
+ * @return Contents of MAPS/<name>.MAP.
+ */
+const std::vector<unsigned char> &MapBlock::getMapFile()
+{
+	if (!_mapFileLoaded)
+	{
+		auto file = FileMap::getIStream("MAPS/" + _name + ".MAP");
+		_mapFile.assign(std::istreambuf_iterator<char>(*file), std::istreambuf_iterator<char>());
+		_mapFileLoaded = true;
+	}
+	return _mapFile;
+}
+
+/**
+ * Gets the raw contents of the RMP file of this block.
+ * The file is only read the first time, every mission
+ * using the block after that gets the same data.
+ * @return Contents of ROUTES/<name>.RMP.
+ */
+const std::vector<unsigned char> &MapBlock::getRouteFile()
+{
+	if (!_routeFileLoaded)
+	{
+		auto file = FileMap::getIStream("ROUTES/" + _name + ".RMP");
+		_routeFile.assign(std::istreambuf_iterator<char>(*file), std::istreambuf_iterator<char>());
+		_routeFileLoaded = true;
+	}
+	return _routeFile;
+}
+
 }
@@ -24,6 +24,7 @@
 #include "../Engine/SurfaceSet.h"
 #include "../Engine/FileMap.h"
 #include "../Engine/Logger.h"
+#include "../Engine/Options.h"
 
 namespace OpenXcom
 {
@@ -245,6 +246,10 @@ void MapDataSet::loadData(MCDPatch *patch, bool validate)
 	// Load terrain sprites/surfaces/PCK files into a surfaceset
 	_surfaceSet = new SurfaceSet(32, 40);
 	_surfaceSet->loadPck("TERRAIN/" + _name + ".PCK", "TERRAIN/" + _name + ".TAB");
+	if (Options::oxceSpriteSpans)
+	{
+		_surfaceSet->buildSpans();
+	}
 }
 
 /**
@@ -2143,6 +2143,10 @@ void Mod::loadAll()
 	afterLoadHelper("craftWeapons", this, _craftWeapons, &RuleCraftWeapon::afterLoad);
 	afterLoadHelper("countries", this, _countries, &RuleCountry::afterLoad);
 
+	// rules are final now, hand out the dense ids
+	_itemLookup.build(_items);
+	_researchLookup.build(_research);
+
 	for (auto& a : _armors)
 	{
 		if (a.second->hasInfiniteSupply())
@@ -2293,6 +2297,14 @@ void Mod::loadAll()
 
 	sortLists();
 	modResources();
+
+	if (Options::oxceSpriteSpans)
+	{
+		for (auto& pair : _sets)
+		{
+			pair.second->buildSpans();
+		}
+	}
 }
 
 /**
@@ -3573,7 +3585,7 @@ T *Mod::loadRule(const YAML::Node &node, std::map<std::string, T*> *map, std::ve
  */
 SavedGame *Mod::newSave(GameDifficulty diff) const
 {
-	SavedGame *save = new SavedGame();
+	SavedGame *save = new SavedGame(this);
 	save->setDifficulty(diff);
 
 	// Add countries
@@ -3725,6 +3737,7 @@ SavedGame *Mod::newSave(GameDifficulty diff) const
 	// Setup alien strategy
 	save->getAlienStrategy().init(this);
 	save->setTime(_startingTime);
+	save->updateResearchIndex(this);
 
 	return save;
 }
@@ -3888,6 +3901,10 @@ RuleItem *Mod::getItem(const std::string &id, bool error) const
 	{
 		return 0;
 	}
+	if (RuleItem *rule = _itemLookup.find(id))
+	{
+		return rule;
+	}
 	return getRule(id, "Item", _items, error);
 }
 
@@ -4279,6 +4296,10 @@ const std::vector<std::string> &Mod::getInvsList() const
  */
 RuleResearch *Mod::getResearch(const std::string &id, bool error) const
 {
+	if (RuleResearch *rule = _researchLookup.find(id))
+	{
+		return rule;
+	}
 	return getRule(id, "Research", _research, error);
 }
 
@@ -5714,6 +5735,8 @@ void Mod::loadBattlescapeResources()
  */
 void Mod::loadExtraResources()
 {
+	Uint32 start = SDL_GetTicks();
+
 	// Load fonts
 	YAML::Node doc = FileMap::getYAML("Language/" + _fontName);
 	Log(LOG_INFO) << "Loading fonts... " << _fontName;
@@ -5724,6 +5747,7 @@ void Mod::loadExtraResources()
 		font->load(*i);
 		_fonts[id] = font;
 	}
+	Uint32 fontsLoaded = SDL_GetTicks();
 
 #ifndef __NO_MUSIC
 	// Load musics
@@ -5772,19 +5796,40 @@ void Mod::loadExtraResources()
 		delete aintrocat;
 	}
 #endif
+	Uint32 musicLoaded = SDL_GetTicks();
 
 	Log(LOG_INFO) << "Lazy loading: " << Options::lazyLoadResources;
 	if (!Options::lazyLoadResources)
 	{
 		Log(LOG_INFO) << "Loading extra resources from ruleset...";
+		std::vector<ExtraSprites*> spritePacks;
 		for (auto& pair : _extraSprites)
 		{
 			for (auto* extraSprites : pair.second)
 			{
-				loadExtraSprite(extraSprites);
+				spritePacks.push_back(extraSprites);
 			}
 		}
+		// decode the images of a batch of packs in parallel, then load the packs in order
+		const size_t preloadBatch = 256;
+		for (size_t i = 0; i < spritePacks.size();)
+		{
+			std::vector<std::string> files;
+			size_t end = i;
+			while (end < spritePacks.size() && files.size() < preloadBatch)
+			{
+				spritePacks[end]->getImageFiles(files);
+				++end;
+			}
+			Surface::preloadImages(files);
+			for (; i < end; ++i)
+			{
+				loadExtraSprite(spritePacks[i]);
+			}
+		}
+		Surface::clearPreloadedImages();
 	}
+	Uint32 spritesLoaded = SDL_GetTicks();
 
 	if (!Options::mute)
 	{
@@ -5802,6 +5847,7 @@ void Mod::loadExtraResources()
 			_sounds[setName] = soundPack->loadSoundSet(set);
 		}
 	}
+	Uint32 soundsLoaded = SDL_GetTicks();
 
 	Log(LOG_INFO) << "Loading custom palettes from ruleset...";
 	for (const auto& pair : _customPalettes)
@@ -5886,6 +5932,8 @@ void Mod::loadExtraResources()
 	Window::soundPopup[0] = getSound("GEO.CAT", Mod::WINDOW_POPUP[0]);
 	Window::soundPopup[1] = getSound("GEO.CAT", Mod::WINDOW_POPUP[1]);
 	Window::soundPopup[2] = getSound("GEO.CAT", Mod::WINDOW_POPUP[2]);
+
+	Log(LOG_INFO) << "Extra resources loaded: fonts " << fontsLoaded - start << "ms, music " << musicLoaded - fontsLoaded << "ms, sprites " << spritesLoaded - musicLoaded << "ms, sounds " << soundsLoaded - spritesLoaded << "ms, palettes " << SDL_GetTicks() - soundsLoaded << "ms.";
 }
 
 void Mod::loadExtraSprite(ExtraSprites *spritePack)
@@ -34,6 +34,7 @@
 #include "RuleAlienMission.h"
 #include "RuleBaseFacilityFunctions.h"
 #include "RuleItem.h"
+#include "RuleLookup.h"
 
 namespace OpenXcom
 {
@@ -171,6 +172,7 @@ private:
 	std::map<std::string, RuleCraftWeapon*> _craftWeapons;
 	std::map<std::string, RuleItemCategory*> _itemCategories;
 	std::map<std::string, RuleItem*> _items;
+	RuleLookup<RuleItem> _itemLookup;
 	std::map<std::string, RuleUfo*> _ufos;
 	std::map<std::string, RuleTerrain*> _terrains;
 	std::map<std::string, MapDataSet*> _mapDataSets;
@@ -186,6 +188,7 @@ private:
 	std::map<std::string, RuleInventory*> _invs;
 	bool _inventoryOverlapsPaperdoll;
 	std::map<std::string, RuleResearch *> _research;
+	RuleLookup<RuleResearch> _researchLookup;
 	std::map<std::string, RuleManufacture *> _manufacture;
 	std::map<std::string, RuleManufactureShortcut *> _manufactureShortcut;
 	std::map<std::string, RuleSoldierBonus *> _soldierBonus;
@@ -696,6 +699,10 @@ public:
 	const std::vector<std::string> &getItemCategoriesList() const;
 	/// Gets the ruleset for an item type.
 	RuleItem *getItem(const std::string &id, bool error = false) const;
+	/// Gets the ruleset for an item id, see RuleLookup.
+	RuleItem *getItemById(int id) const { return _itemLookup.get(id); }
+	/// Gets the number of item ids.
+	int getItemIdCount() const { return _itemLookup.size(); }
 	/// Gets the available items.
 	const std::vector<std::string> &getItemsList() const;
 	/// Gets the ruleset for a UFO type.
@@ -984,6 +991,10 @@ public:
 
 	/// Gets the ruleset for a specific research project.
 	RuleResearch *getResearch(const std::string &id, bool error = false) const;
+	/// Gets the ruleset for a research id, see RuleLookup.
+	RuleResearch *getResearchById(int id) const { return _researchLookup.get(id); }
+	/// Gets the number of research ids.
+	int getResearchIdCount() const { return _researchLookup.size(); }
 	/// Gets the ruleset for a specific research project.
 	std::vector<const RuleResearch*> getResearch(const std::vector<std::string> &id) const;
 	/// Gets the ruleset for a specific research project.
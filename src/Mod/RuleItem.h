@@ -398,6 +398,7 @@ private:
 	bool _arcingShot;
 	ExperienceTrainingMode _experienceTrainingMode;
 	int _manaExperience;
+	int _ruleId = -1;
 	int _listOrder, _maxRange, _minRange, _dropoff, _bulletSpeed, _explosionSpeed, _shotgunPellets;
 	int _shotgunBehaviorType, _shotgunSpread, _shotgunChoke;
 
@@ -843,6 +844,10 @@ public:
 	int getAttraction() const;
 	/// Get the list weight for this item.
 	int getListOrder() const;
+	/// Gets the dense id of this item, see RuleLookup.
+	int getRuleId() const { return _ruleId; }
+	/// Sets the dense id of this item.
+	void setRuleId(int id) { _ruleId = id; }
 	/// How fast does a projectile fired from this weapon travel?
 	int getBulletSpeed() const;
 	/// How fast does the explosion animation play?
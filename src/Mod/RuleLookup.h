@@ -0,0 +1,72 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace OpenXcom
+{
+
+/**
+ * Gives every rule of one kind a dense integer id and a hashed
+ * lookup by name. Built once all the mods are loaded, so hot code
+ * can keep per-rule data in plain arrays instead of string maps.
+ * Ids follow the order of the rule map, so they are the same
+ * on every run with the same mods.
+ */
+template<typename T>
+class RuleLookup
+{
+private:
+	std::vector<T*> _rules;
+	std::unordered_map<std::string, T*> _names;
+public:
+	/// Numbers the rules and indexes their names.
+	void build(const std::map<std::string, T*> &map)
+	{
+		_rules.clear();
+		_names.clear();
+		_names.reserve(map.size());
+		for (const auto& pair : map)
+		{
+			if (pair.second != 0)
+			{
+				pair.second->setRuleId((int)_rules.size());
+				_rules.push_back(pair.second);
+				_names[pair.first] = pair.second;
+			}
+		}
+	}
+	/// Gets a rule by its id.
+	T *get(int id) const { return _rules[id]; }
+	/// Gets a rule by its name, or null if there is none.
+	T *find(const std::string &name) const
+	{
+		auto i = _names.find(name);
+		return i != _names.end() ? i->second : 0;
+	}
+	/// Gets the number of ids handed out.
+	int size() const { return (int)_rules.size(); }
+	/// Checks if the lookup was built yet.
+	bool empty() const { return _rules.empty(); }
+};
+
+}
@@ -56,6 +56,7 @@ class RuleResearch
 	std::vector<std::pair<const RuleResearch*, std::vector<const RuleResearch*> > > _getOneFreeProtected;
 	bool _needItem, _destroyItem, _unlockFinalMission;
 	int _listOrder;
+	int _ruleId = -1;
 
 	ScriptValues<RuleResearch> _scriptValues;
 public:
@@ -108,6 +109,10 @@ public:
 	RuleBaseFacilityFunctions getRequireBaseFunc() const { return _requiresBaseFunc; }
 	/// Gets the list weight for this research item.
 	int getListOrder() const;
+	/// Gets the dense id of this research item, see RuleLookup.
+	int getRuleId() const { return _ruleId; }
+	/// Sets the dense id of this research item.
+	void setRuleId(int id) { _ruleId = id; }
 	/// Gets the cutscene to play when this item is researched
 	const std::string & getCutscene() const;
 	/// Gets the item to spawn in the base stores when this topic is researched.
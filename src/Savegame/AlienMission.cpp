@@ -25,6 +25,7 @@
 #include "../Engine/Logger.h"
 #include "../Engine/RNG.h"
 #include "../Geoscape/Globe.h"
+#include "../Geoscape/LandingPointPool.h"
 #include "../Mod/RuleAlienMission.h"
 #include "../Mod/RuleRegion.h"
 #include "../Mod/RuleCountry.h"
@@ -1275,40 +1276,10 @@ std::pair<double, double> AlienMission::getLandPoint(const Globe &globe, const R
 	}
 	else
 	{
-		int tries = 0;
 		bool wantsToLandOnFakeWater = RNG::percent(ufo.getRules()->getFakeWaterLandingChance());
-		bool found = false;
-		while (!found)
-		{
-			pos = region.getRandomPoint(zone);
-			++tries;
-
-			if (tries == 100)
-			{
-				found = true; // forced decision
-			}
-			else if (globe.insideLand(pos.first, pos.second) && region.insideRegion(pos.first, pos.second))
-			{
-				bool isFakeWater = globe.insideFakeUnderwaterTexture(pos.first, pos.second);
-				if (wantsToLandOnFakeWater)
-				{
-					if (isFakeWater)
-					{
-						found = true; // found landing point on fake water
-					}
-				}
-				else
-				{
-					if (!isFakeWater)
-					{
-						found = true; // found landing point on land
-					}
-				}
-			}
-		}
-
-		if (tries == 100)
+		if (!globe.getLandingPoints().getPoint(globe, region, zone, -1, wantsToLandOnFakeWater, pos))
 		{
+			pos = region.getRandomPoint(zone); // forced decision
 			Log(LOG_WARNING) << "Region: " << region.getType() << " Longitude: " << pos.first << " Latitude: " << pos.second << " invalid zone: " << zone << " ufo forced to land on water (or invalid texture)!";
 			if (wantsToLandOnFakeWater)
 			{
@@ -1345,46 +1316,14 @@ std::pair<double, double> AlienMission::getLandPointForMissionSite(const Globe&
 	}
 
 	std::pair<double, double> pos;
+	bool wantsToLandOnFakeWater = RNG::percent(ufo.getRules()->getFakeWaterLandingChance());
+	if (!globe.getLandingPoints().getPoint(globe, region, zone, area, wantsToLandOnFakeWater, pos)) // the area doesn't need to be inside the region!
 	{
-		int tries = 0;
-		bool wantsToLandOnFakeWater = RNG::percent(ufo.getRules()->getFakeWaterLandingChance());
-		bool found = false;
-		while (!found)
-		{
-			pos = region.getRandomPoint(zone, area); // pass the area as a parameter too!
-			++tries;
-
-			if (tries == 100)
-			{
-				found = true; // forced decision
-			}
-			else if (globe.insideLand(pos.first, pos.second) /* && region.insideRegion(pos.first, pos.second) */) // doesn't need to be inside the region!
-			{
-				bool isFakeWater = globe.insideFakeUnderwaterTexture(pos.first, pos.second);
-				if (wantsToLandOnFakeWater)
-				{
-					if (isFakeWater)
-					{
-						found = true; // found landing point on fake water
-					}
-				}
-				else
-				{
-					if (!isFakeWater)
-					{
-						found = true; // found landing point on land
-					}
-				}
-			}
-		}
-
-		if (tries == 100)
+		pos = region.getRandomPoint(zone, area); // forced decision
+		Log(LOG_WARNING) << "Region: " << region.getType() << " Longitude: " << pos.first << " Latitude: " << pos.second << " zone: " << zone << " area: " << area << " ufo forced to land on water (or invalid texture)!";
+		if (wantsToLandOnFakeWater)
 		{
-			Log(LOG_WARNING) << "Region: " << region.getType() << " Longitude: " << pos.first << " Latitude: " << pos.second << " zone: " << zone << " area: " << area << " ufo forced to land on water (or invalid texture)!";
-			if (wantsToLandOnFakeWater)
-			{
-				Log(LOG_WARNING) << "UFO: " << ufo.getRules()->getType() << " wanted to land on fake water.";
-			}
+			Log(LOG_WARNING) << "UFO: " << ufo.getRules()->getType() << " wanted to land on fake water.";
 		}
 	}
 	return pos;
@@ -44,12 +44,21 @@
 #include "../Mod/RuleSoldier.h"
 #include "../Engine/Logger.h"
 #include "../Engine/Collections.h"
+#include "../Engine/Parallel.h"
 #include "WeightedOptions.h"
 #include "AlienMission.h"
 
 namespace OpenXcom
 {
 
+namespace
+{
+
+/// Fewest changed soldiers worth spreading the stat calculation over several threads.
+const size_t SoldierStatsParallelMinimum = 64;
+
+}
+
 /**
  * Initializes an empty base.
  * @param mod Pointer to mod.
@@ -57,7 +66,7 @@ namespace OpenXcom
 Base::Base(const Mod *mod) : Target(), _mod(mod), _scientists(0), _engineers(0), _inBattlescape(false),
 	_retaliationTarget(false), _retaliationMission(nullptr), _fakeUnderwater(false)
 {
-	_items = new ItemContainer();
+	_items = new ItemContainer(mod);
 }
 
 /**
@@ -127,7 +136,7 @@ void Base::load(const YAML::Node &node, SavedGame *save, bool newGame, bool newB
 		std::string type = (*i)["type"].as<std::string>();
 		if (_mod->getCraft(type))
 		{
-			Craft *c = new Craft(_mod->getCraft(type), this);
+			Craft *c = new Craft(_mod->getCraft(type), _mod, this);
 			c->load(*i, _mod->getScriptGlobal(), _mod, save);
 			_crafts.push_back(c);
 		}
@@ -165,20 +174,8 @@ void Base::load(const YAML::Node &node, SavedGame *save, bool newGame, bool newB
 		}
 	}
 
+	// Some old saves have bad items, the container drops them
 	_items->load(node["items"]);
-	// Some old saves have bad items, better get rid of them to avoid further bugs
-	for (auto iter = _items->getContents()->begin(); iter != _items->getContents()->end();)
-	{
-		if (_mod->getItem(iter->first) == 0)
-		{
-			Log(LOG_ERROR) << "Failed to load item " << iter->first;
-			_items->getContents()->erase(iter++);
-		}
-		else
-		{
-			++iter;
-		}
-	}
 
 	_scientists = node["scientists"].as<int>(_scientists);
 	_engineers = node["engineers"].as<int>(_engineers);
@@ -241,6 +238,8 @@ void Base::load(const YAML::Node &node, SavedGame *save, bool newGame, bool newB
 	}
 	_fakeUnderwater = node["fakeUnderwater"].as<bool>(_fakeUnderwater);
 
+	updateCapacity();
+
 	isOverlappingOrOverflowing(); // don't crash, just report in the log file...
 }
 
@@ -407,6 +406,8 @@ int Base::getMarker() const
 
 /**
  * Returns the list of facilities in the base.
+ * Anything that adds, removes or finishes facilities
+ * has to call updateCapacity() afterwards.
  * @return Pointer to the facility list.
  */
 std::vector<BaseFacility*> *Base::getFacilities()
@@ -414,6 +415,94 @@ std::vector<BaseFacility*> *Base::getFacilities()
 	return &_facilities;
 }
 
+/**
+ * Recalculates the cached totals of the base facilities.
+ * Capacity getters are called every frame by the base screens
+ * and every tick by the geoscape, while facilities only change
+ * when built, finished, dismantled or destroyed.
+ */
+void Base::updateCapacity()
+{
+	_capacity = calcCapacity();
+}
+
+/**
+ * Adds up the space, functions and detection
+ * provided by all the facilities in the base.
+ * @return Facility totals.
+ */
+BaseCapacity Base::calcCapacity() const
+{
+	BaseCapacity total;
+	int minRadarRange = _mod->getShortRadarRange();
+	for (const auto* fac : _facilities)
+	{
+		const RuleBaseFacility *rule = fac->getRules();
+		total.forbiddenBaseFunc |= rule->getForbiddenBaseFunc();
+		if (fac->getBuildTime() != 0)
+		{
+			continue;
+		}
+		total.quarters += rule->getPersonnel();
+		total.stores += rule->getStorage();
+		total.laboratories += rule->getLaboratories();
+		total.workshops += rule->getWorkshops();
+		total.hangars += rule->getCrafts();
+		total.psiLaboratories += rule->getPsiLaboratories();
+		total.training += rule->getTrainingFacilities();
+		total.defenseValue += rule->getDefenseValue();
+		if (minRadarRange != 0 && rule->getRadarRange() > 0 && rule->getRadarRange() <= minRadarRange)
+		{
+			total.shortRangeDetection++;
+		}
+		if (rule->getRadarRange() > minRadarRange)
+		{
+			total.longRangeDetection++;
+		}
+		if (rule->isGravShield())
+		{
+			total.gravShields++;
+		}
+		total.radarRange = std::max(total.radarRange, rule->getRadarRange());
+		total.containment[rule->getPrisonType()] += rule->getAliens();
+		total.providedBaseFunc |= rule->getProvidedBaseFunc();
+	}
+	return total;
+}
+
+/**
+ * Returns the cached facility totals. In debug mode they are checked
+ * against a full recalculation, to catch code that changes
+ * the facilities without calling updateCapacity().
+ * @return Facility totals.
+ */
+const BaseCapacity &Base::getCapacity() const
+{
+	if (Options::debug)
+	{
+		BaseCapacity real = calcCapacity();
+		if (real.quarters != _capacity.quarters ||
+			real.stores != _capacity.stores ||
+			real.laboratories != _capacity.laboratories ||
+			real.workshops != _capacity.workshops ||
+			real.hangars != _capacity.hangars ||
+			real.psiLaboratories != _capacity.psiLaboratories ||
+			real.training != _capacity.training ||
+			real.defenseValue != _capacity.defenseValue ||
+			real.shortRangeDetection != _capacity.shortRangeDetection ||
+			real.longRangeDetection != _capacity.longRangeDetection ||
+			real.gravShields != _capacity.gravShields ||
+			real.radarRange != _capacity.radarRange ||
+			real.containment != _capacity.containment ||
+			real.providedBaseFunc != _capacity.providedBaseFunc ||
+			real.forbiddenBaseFunc != _capacity.forbiddenBaseFunc)
+		{
+			Log(LOG_ERROR) << "Base " << _name << " has outdated facility totals, updateCapacity() was not called.";
+		}
+	}
+	return _capacity;
+}
+
 /**
  * Returns the list of soldiers in the base.
  * @return Pointer to the soldier list.
@@ -425,13 +514,31 @@ std::vector<Soldier*> *Base::getSoldiers()
 
 /**
  * Pre-calculates soldier stats with various bonuses.
+ * Only soldiers that changed since the last time are recalculated,
+ * spread over several threads when there are many of them.
  */
 void Base::prepareSoldierStatsWithBonuses()
 {
+	std::vector<Soldier*> changed;
 	for (auto* soldier : _soldiers)
 	{
-		soldier->prepareStatsWithBonuses(_mod);
+		if (!soldier->hasStatsWithBonuses(_mod))
+		{
+			changed.push_back(soldier);
+		}
+	}
+	if (changed.size() < SoldierStatsParallelMinimum)
+	{
+		for (auto* soldier : changed)
+		{
+			soldier->prepareStatsWithBonuses(_mod);
+		}
+		return;
 	}
+	Parallel::forEach(changed.size(), [&](int i)
+	{
+		changed[i]->prepareStatsWithBonuses(_mod);
+	});
 }
 
 /**
@@ -572,7 +679,7 @@ int Base::getAvailableSoldiers(bool checkCombatReadiness, bool includeWounded) c
 		{
 			total++;
 		}
-		else if (checkCombatReadiness && ((soldier->getCraft() != 0 && soldier->getCraft()->getStatus() != "STR_OUT") ||
+		else if (checkCombatReadiness && ((soldier->getCraft() != 0 && soldier->getCraft()->getStatusId() != CRAFT_OUT) ||
 			(soldier->getCraft() == 0 && (soldier->hasFullHealth() || (includeWounded && soldier->canDefendBase())))))
 		{
 			total++;
@@ -704,9 +811,9 @@ int Base::getTotalOtherStaffAndInventoryCost(int& staffCount, int& inventoryCoun
 			}
 		}
 	}
-	for (const auto& storeItem : *_items->getContents())
+	for (const auto& storeItem : *_items)
 	{
-		auto* ruleItem = _mod->getItem(storeItem.first, true);
+		auto* ruleItem = storeItem.first;
 		if (ruleItem->getMonthlySalary() != 0)
 		{
 			staffCount += storeItem.second;
@@ -720,9 +827,9 @@ int Base::getTotalOtherStaffAndInventoryCost(int& staffCount, int& inventoryCoun
 	}
 	for (auto* xcraft : _crafts)
 	{
-		for (const auto& craftItem : *xcraft->getItems()->getContents())
+		for (const auto& craftItem : *xcraft->getItems())
 		{
-			auto* ruleItem = _mod->getItem(craftItem.first, true);
+			auto* ruleItem = craftItem.first;
 			if (ruleItem->getMonthlySalary() != 0)
 			{
 				staffCount += craftItem.second;
@@ -793,15 +900,7 @@ int Base::getUsedQuarters() const
  */
 int Base::getAvailableQuarters() const
 {
-	int total = 0;
-	for (const auto* fac : _facilities)
-	{
-		if (fac->getBuildTime() == 0)
-		{
-			total += fac->getRules()->getPersonnel();
-		}
-	}
-	return total;
+	return getCapacity().quarters;
 }
 
 /**
@@ -811,7 +910,7 @@ int Base::getAvailableQuarters() const
  */
 double Base::getUsedStores(bool excludeNormalItems) const
 {
-	double total = excludeNormalItems ? 0.0 : _items->getTotalSize(_mod);
+	double total = excludeNormalItems ? 0.0 : _items->getTotalSize();
 	for (const auto* xcraft : _crafts)
 	{
 		total += xcraft->getTotalItemStorageSize(_mod);
@@ -864,15 +963,7 @@ bool Base::storesOverfullCritical() const
  */
 int Base::getAvailableStores() const
 {
-	int total = 0;
-	for (const auto* fac : _facilities)
-	{
-		if (fac->getBuildTime() == 0)
-		{
-			total += fac->getRules()->getStorage();
-		}
-	}
-	return total;
+	return getCapacity().stores;
 }
 
 /**
@@ -897,15 +988,7 @@ int Base::getUsedLaboratories() const
  */
 int Base::getAvailableLaboratories() const
 {
-	int total = 0;
-	for (const auto* fac : _facilities)
-	{
-		if (fac->getBuildTime() == 0)
-		{
-			total += fac->getRules()->getLaboratories();
-		}
-	}
-	return total;
+	return getCapacity().laboratories;
 }
 
 /**
@@ -930,15 +1013,7 @@ int Base::getUsedWorkshops() const
  */
 int Base::getAvailableWorkshops() const
 {
-	int total = 0;
-	for (const auto* fac : _facilities)
-	{
-		if (fac->getBuildTime() == 0)
-		{
-			total += fac->getRules()->getWorkshops();
-		}
-	}
-	return total;
+	return getCapacity().workshops;
 }
 
 /**
@@ -974,15 +1049,7 @@ int Base::getUsedHangars() const
  */
 int Base::getAvailableHangars() const
 {
-	int total = 0;
-	for (const auto* fac : _facilities)
-	{
-		if (fac->getBuildTime() == 0)
-		{
-			total += fac->getRules()->getCrafts();
-		}
-	}
-	return total;
+	return getCapacity().hangars;
 }
 
 /**
@@ -1056,15 +1123,7 @@ int Base::getAllocatedEngineers() const
  */
 int Base::getDefenseValue() const
 {
-	int total = 0;
-	for (const auto* fac : _facilities)
-	{
-		if (fac->getBuildTime() == 0)
-		{
-			total += fac->getRules()->getDefenseValue();
-		}
-	}
-	return total;
+	return getCapacity().defenseValue;
 }
 
 /**
@@ -1074,18 +1133,7 @@ int Base::getDefenseValue() const
  */
 int Base::getShortRangeDetection() const
 {
-	int total = 0;
-	int minRadarRange = _mod->getShortRadarRange();
-
-	if (minRadarRange == 0) return 0;
-	for (const auto* fac : _facilities)
-	{
-		if (fac->getRules()->getRadarRange() > 0 && fac->getRules()->getRadarRange() <= minRadarRange && fac->getBuildTime() == 0)
-		{
-			total++;
-		}
-	}
-	return total;
+	return getCapacity().shortRangeDetection;
 }
 
 /**
@@ -1095,17 +1143,17 @@ int Base::getShortRangeDetection() const
  */
 int Base::getLongRangeDetection() const
 {
-	int total = 0;
-	int minRadarRange = _mod->getShortRadarRange();
+	return getCapacity().longRangeDetection;
+}
 
-	for (const auto* fac : _facilities)
-	{
-		if (fac->getRules()->getRadarRange() > minRadarRange && fac->getBuildTime() == 0)
-		{
-			total++;
-		}
-	}
-	return total;
+/**
+ * Returns the longest radar range of all
+ * the finished facilities in the base.
+ * @return Range in nautical miles.
+ */
+int Base::getMaxRadarRange() const
+{
+	return getCapacity().radarRange;
 }
 
 /**
@@ -1142,7 +1190,7 @@ int Base::getCraftCountForProduction(const RuleCraft *craft) const
 	int total = 0;
 	for (const auto* xcraft : _crafts)
 	{
-		if (xcraft->getRules() == craft && xcraft->getStatus() != "STR_OUT")
+		if (xcraft->getRules() == craft && xcraft->getStatusId() != CRAFT_OUT)
 		{
 			total++;
 		}
@@ -1338,15 +1386,7 @@ const std::vector<Production *> & Base::getProductions() const
  */
 int Base::getAvailablePsiLabs() const
 {
-	int total = 0;
-	for (const auto* fac : _facilities)
-	{
-		if (fac->getBuildTime() == 0)
-		{
-			total += fac->getRules()->getPsiLaboratories();
-		}
-	}
-	return total;
+	return getCapacity().psiLaboratories;
 }
 
 /**
@@ -1385,15 +1425,7 @@ int Base::getUsedPsiLabs() const
  */
 int Base::getAvailableTraining() const
 {
-	int total = 0;
-	for (const auto* fac : _facilities)
-	{
-		if (fac->getBuildTime() == 0)
-		{
-			total += fac->getRules()->getTrainingFacilities();
-		}
-	}
-	return total;
+	return getCapacity().training;
 }
 
 /**
@@ -1460,9 +1492,9 @@ int Base::getUsedContainment(int prisonType, bool onlyExternal) const
 		return total;
 	}
 
-	for (const auto& pair : *_items->getContents())
+	for (const auto& pair : *_items)
 	{
-		rule = _mod->getItem(pair.first, true);
+		rule = pair.first;
 		if (rule->isAlien() && rule->getPrisonType() == prisonType)
 		{
 			total += pair.second;
@@ -1478,15 +1510,9 @@ int Base::getUsedContainment(int prisonType, bool onlyExternal) const
  */
 int Base::getAvailableContainment(int prisonType) const
 {
-	int total = 0;
-	for (const auto* fac : _facilities)
-	{
-		if (fac->getBuildTime() == 0 && fac->getRules()->getPrisonType() == prisonType)
-		{
-			total += fac->getRules()->getAliens();
-		}
-	}
-	return total;
+	const auto &containment = getCapacity().containment;
+	auto it = containment.find(prisonType);
+	return it != containment.end() ? it->second : 0;
 }
 
 /**
@@ -1551,15 +1577,7 @@ size_t Base::getDetectionChance() const
 
 int Base::getGravShields() const
 {
-	int total = 0;
-	for (const auto* fac : _facilities)
-	{
-		if (fac->getBuildTime() == 0 && fac->getRules()->isGravShield())
-		{
-			++total;
-		}
-	}
-	return total;
+	return getCapacity().gravShields;
 }
 
 void Base::setupDefenses(AlienMission* am)
@@ -1585,7 +1603,7 @@ void Base::setupDefenses(AlienMission* am)
 	// add vehicles that are in the crafts of the base, if it's not out
 	for (auto* xcraft : _crafts)
 	{
-		if (xcraft->getStatus() != "STR_OUT")
+		if (xcraft->getStatusId() != CRAFT_OUT)
 		{
 			for (auto* vehicle : *xcraft->getVehicles())
 			{
@@ -1595,11 +1613,10 @@ void Base::setupDefenses(AlienMission* am)
 	}
 
 	// add vehicles left on the base
-	for (auto iter = _items->getContents()->begin(); iter != _items->getContents()->end(); )
+	for (const auto& pair : *_items)
 	{
-		const auto& itemId = iter->first;
-		int itemQty = iter->second;
-		RuleItem *rule = _mod->getItem(itemId, true);
+		RuleItem *rule = pair.first;
+		int itemQty = pair.second;
 		if (rule->getVehicleUnit())
 		{
 			int size = rule->getVehicleUnit()->getArmor()->getTotalSize();
@@ -1611,7 +1628,7 @@ void Base::setupDefenses(AlienMission* am)
 					_vehicles.push_back(vehicle);
 					_vehiclesFromBase.push_back(vehicle);
 				}
-				_items->removeItem(itemId, itemQty);
+				_items->removeItem(rule, itemQty);
 			}
 			else // so this vehicle needs ammo
 			{
@@ -1621,7 +1638,6 @@ void Base::setupDefenses(AlienMission* am)
 				int baseQty = _items->getItem(ammo) / ammoPerVehicle;
 				if (!baseQty)
 				{
-					++iter;
 					continue;
 				}
 				int canBeAdded = std::min(itemQty, baseQty);
@@ -1632,12 +1648,9 @@ void Base::setupDefenses(AlienMission* am)
 					_vehiclesFromBase.push_back(vehicle);
 					_items->removeItem(ammo, ammoPerVehicle);
 				}
-				_items->removeItem(itemId, canBeAdded);
+				_items->removeItem(rule, canBeAdded);
 			}
-
-			iter = _items->getContents()->begin(); // we have to start over because iterator is broken because of the removeItem
 		}
-		else ++iter;
 	}
 }
 
@@ -1735,6 +1748,7 @@ int Base::damageFacility(BaseFacility *toBeDamaged)
 			}
 		}
 	}
+	updateCapacity();
 
 	// 2. Now destroy the original
 	for (auto iter = _facilities.begin(); iter != _facilities.end(); ++iter)
@@ -1876,12 +1890,12 @@ void Base::destroyFacility(BASEFACILITIESITERATOR facility)
 			}
 
 			// remove all items
-			while (!(*facility)->getCraftForDrawing()->getItems()->getContents()->empty())
+			ItemContainer *craftItems = (*facility)->getCraftForDrawing()->getItems();
+			for (const auto& pair : *craftItems)
 			{
-				auto i = (*facility)->getCraftForDrawing()->getItems()->getContents()->begin();
-				_items->addItem(i->first, i->second);
-				(*facility)->getCraftForDrawing()->getItems()->removeItem(i->first, i->second);
+				_items->addItem(pair.first, pair.second);
 			}
+			craftItems->clear();
 			Collections::deleteIf(_crafts, 1,
 				[&](Craft* c)
 				{
@@ -2039,6 +2053,7 @@ void Base::destroyFacility(BASEFACILITIESITERATOR facility)
 	_destroyedFacilitiesCache[(*facility)->getRules()] += 1;
 	delete *facility;
 	_facilities.erase(facility);
+	updateCapacity();
 }
 
 /**
@@ -2327,6 +2342,11 @@ BasePlacementErrors Base::isAreaInUse(BaseAreaSubset area, const RuleBaseFacilit
  */
 RuleBaseFacilityFunctions Base::getProvidedBaseFunc(BaseAreaSubset skip) const
 {
+	if (!skip)
+	{
+		return getCapacity().providedBaseFunc;
+	}
+
 	RuleBaseFacilityFunctions ret = 0;
 
 	for (const auto* bf : _facilities)
@@ -2382,6 +2402,11 @@ RuleBaseFacilityFunctions Base::getRequireBaseFunc(BaseAreaSubset skip) const
  */
 RuleBaseFacilityFunctions Base::getForbiddenBaseFunc(BaseAreaSubset skip) const
 {
+	if (!skip)
+	{
+		return getCapacity().forbiddenBaseFunc;
+	}
+
 	RuleBaseFacilityFunctions ret = 0;
 
 	for (const auto* bf : _facilities)
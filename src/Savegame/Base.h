@@ -84,6 +84,31 @@ struct BaseSumDailyRecovery
 	float SickBayAbsoluteBonus = 0.0f;
 };
 
+/**
+ * Totals of everything the facilities of a base provide.
+ * Only finished facilities count, except for the forbidden functions.
+ */
+struct BaseCapacity
+{
+	int quarters = 0;
+	int stores = 0;
+	int laboratories = 0;
+	int workshops = 0;
+	int hangars = 0;
+	int psiLaboratories = 0;
+	int training = 0;
+	int defenseValue = 0;
+	int shortRangeDetection = 0;
+	int longRangeDetection = 0;
+	int gravShields = 0;
+	/// Longest radar range of any finished facility.
+	int radarRange = 0;
+	/// Alien containment space by prison type.
+	std::map<int, int> containment;
+	RuleBaseFacilityFunctions providedBaseFunc = 0;
+	RuleBaseFacilityFunctions forbiddenBaseFunc = 0;
+};
+
 /**
  * Represents a player base on the globe.
  * Bases can contain facilities, personnel, crafts and equipment.
@@ -109,6 +134,12 @@ private:
 	std::vector<Vehicle*> _vehiclesFromBase;
 	std::vector<BaseFacility*> _defenses;
 	std::map<const RuleBaseFacility*, int> _destroyedFacilitiesCache;
+	BaseCapacity _capacity;
+
+	/// Adds up what the base facilities provide.
+	BaseCapacity calcCapacity() const;
+	/// Gets the cached facility totals.
+	const BaseCapacity &getCapacity() const;
 
 	using Target::load;
 public:
@@ -132,6 +163,8 @@ public:
 	int getMarker() const override;
 	/// Gets the base's facilities.
 	std::vector<BaseFacility*> *getFacilities();
+	/// Recalculates the cached facility totals.
+	void updateCapacity();
 	/// Gets the base's soldiers.
 	std::vector<Soldier*> *getSoldiers();
 	/// Pre-calculates soldier stats with various bonuses.
@@ -210,6 +243,8 @@ public:
 	int getShortRangeDetection() const;
 	/// Gets the base's long range detection.
 	int getLongRangeDetection() const;
+	/// Gets the longest radar range of the base.
+	int getMaxRadarRange() const;
 	/// Gets the base's crafts of a certain type.
 	int getCraftCount(const RuleCraft *craft) const;
 	/// Gets the base's crafts of a certain type.
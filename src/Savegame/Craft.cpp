@@ -78,24 +78,33 @@ namespace YAML
 namespace OpenXcom
 {
 
+namespace
+{
+
+/// Status strings for each CraftStatus, as shown and saved.
+const std::string CraftStatusNames[] = { "STR_READY", "STR_REFUELLING", "STR_REARMING", "STR_REPAIRS", "STR_OUT" };
+
+}
+
 /**
  * Initializes a craft of the specified type and
  * assigns it the latest craft ID available.
  * @param rules Pointer to ruleset.
+ * @param mod Pointer to mod.
  * @param base Pointer to base of origin.
  * @param id ID to assign to the craft (0 to not assign).
  */
-Craft::Craft(const RuleCraft *rules, Base *base, int id) : MovingTarget(),
+Craft::Craft(const RuleCraft *rules, const Mod *mod, Base *base, int id) : MovingTarget(),
 	_rules(rules), _base(base), _fuel(0), _damage(0), _shield(0),
 	_interceptionOrder(0), _takeoff(0), _weapons(),
-	_status("STR_READY"), _lowFuel(false), _mission(false),
+	_status(CRAFT_READY), _lowFuel(false), _mission(false),
 	_inBattlescape(false), _inDogfight(false), _stats(),
 	_isAutoPatrolling(false), _lonAuto(0.0), _latAuto(0.0),
 	_skinIndex(0)
 {
 	_stats = rules->getStats();
-	_items = new ItemContainer();
-	_tempSoldierItems = new ItemContainer();
+	_items = new ItemContainer(mod);
+	_tempSoldierItems = new ItemContainer(mod);
 	if (id != 0)
 	{
 		_id = id;
@@ -175,20 +184,8 @@ void Craft::load(const YAML::Node &node, const ScriptGlobal *shared, const Mod *
 		}
 	}
 
+	// Some old saves have bad items, the container drops them
 	_items->load(node["items"]);
-	// Some old saves have bad items, better get rid of them to avoid further bugs
-	for (auto iter = _items->getContents()->begin(); iter != _items->getContents()->end();)
-	{
-		if (mod->getItem(iter->first) == 0)
-		{
-			Log(LOG_ERROR) << "Failed to load item " << iter->first;
-			_items->getContents()->erase(iter++);
-		}
-		else
-		{
-			++iter;
-		}
-	}
 	for (YAML::const_iterator i = node["vehicles"].begin(); i != node["vehicles"].end(); ++i)
 	{
 		std::string type = (*i)["type"].as<std::string>();
@@ -213,7 +210,19 @@ void Craft::load(const YAML::Node &node, const ScriptGlobal *shared, const Mod *
 			Log(LOG_ERROR) << "Failed to load vehicles item " << type;
 		}
 	}
-	_status = node["status"].as<std::string>(_status);
+	if (const YAML::Node &status = node["status"])
+	{
+		std::string name = status.as<std::string>();
+		auto found = std::find(std::begin(CraftStatusNames), std::end(CraftStatusNames), name);
+		if (found != std::end(CraftStatusNames))
+		{
+			_status = (CraftStatus)(found - std::begin(CraftStatusNames));
+		}
+		else
+		{
+			Log(LOG_ERROR) << "Unknown craft status " << name;
+		}
+	}
 	_lowFuel = node["lowFuel"].as<bool>(_lowFuel);
 	_mission = node["mission"].as<bool>(_mission);
 	_interceptionOrder = node["interceptionOrder"].as<int>(_interceptionOrder);
@@ -375,7 +384,7 @@ YAML::Node Craft::save(const ScriptGlobal *shared) const
 	{
 		node["vehicles"].push_back(vehicle->save());
 	}
-	node["status"] = _status;
+	node["status"] = CraftStatusNames[_status];
 	if (_lowFuel)
 		node["lowFuel"] = _lowFuel;
 	if (_mission)
@@ -471,7 +480,7 @@ std::string Craft::getDefaultName(Language *lang) const
  */
 int Craft::getMarker() const
 {
-	if (_status != "STR_OUT")
+	if (_status != CRAFT_OUT)
 		return -1;
 	else if (_rules->getMarker() == -1)
 		return 1;
@@ -506,16 +515,16 @@ void Craft::setBase(Base *base, bool move)
  * Returns the current status of the craft.
  * @return Status string.
  */
-std::string Craft::getStatus() const
+const std::string &Craft::getStatus() const
 {
-	return _status;
+	return CraftStatusNames[_status];
 }
 
 /**
  * Changes the current status of the craft.
- * @param status Status string.
+ * @param status Status.
  */
-void Craft::setStatus(const std::string &status)
+void Craft::setStatus(CraftStatus status)
 {
 	_status = status;
 }
@@ -544,7 +553,7 @@ std::string Craft::getAltitude() const
  */
 void Craft::setDestination(Target *dest)
 {
-	if (_status != "STR_OUT")
+	if (_status != CRAFT_OUT)
 	{
 		_takeoff = 60;
 	}
@@ -667,7 +676,7 @@ std::vector<Vehicle*> *Craft::getVehicles()
  */
 void Craft::calculateTotalSoldierEquipment()
 {
-	_tempSoldierItems->getContents()->clear();
+	_tempSoldierItems->clear();
 
 	for (auto* soldier : *_base->getSoldiers())
 	{
@@ -699,7 +708,7 @@ void Craft::calculateTotalSoldierEquipment()
  */
 double Craft::getTotalItemStorageSize(const Mod* mod) const
 {
-	double total = _items->getTotalSize(mod);
+	double total = _items->getTotalSize();
 
 	for (const auto* v : _vehicles)
 	{
@@ -1139,19 +1148,19 @@ void Craft::checkup()
 
 	if (_damage > 0)
 	{
-		_status = "STR_REPAIRS";
+		_status = CRAFT_REPAIRS;
 	}
 	else if (available != full)
 	{
-		_status = "STR_REARMING";
+		_status = CRAFT_REARMING;
 	}
 	else if (_fuel < _stats.fuelMax)
 	{
-		_status = "STR_REFUELLING";
+		_status = CRAFT_REFUELLING;
 	}
 	else
 	{
-		_status = "STR_READY";
+		_status = CRAFT_READY;
 	}
 }
 
@@ -1271,7 +1280,7 @@ void Craft::repair()
 	setDamage(_damage - _rules->getRepairRate());
 	if (_damage <= 0)
 	{
-		_status = "STR_REARMING";
+		_status = CRAFT_REARMING;
 	}
 }
 
@@ -1303,7 +1312,7 @@ std::string Craft::refuel()
 				fuel = item;
 				if (_fuel > 0)
 				{
-					_status = "STR_READY";
+					_status = CRAFT_READY;
 				}
 				else
 				{
@@ -1314,12 +1323,12 @@ std::string Craft::refuel()
 	}
 	if (_fuel >= _stats.fuelMax)
 	{
-		_status = "STR_READY";
+		_status = CRAFT_READY;
 		for (const auto* cw : _weapons)
 		{
 			if (cw && cw->isRearming())
 			{
-				_status = "STR_REARMING";
+				_status = CRAFT_REARMING;
 				break;
 			}
 		}
@@ -1340,7 +1349,7 @@ const RuleItem* Craft::rearm()
 	{
 		if (iter == _weapons.end())
 		{
-			_status = "STR_REFUELLING";
+			_status = CRAFT_REFUELLING;
 			break;
 		}
 		CraftWeapon* cw = (*iter);
@@ -1778,7 +1787,7 @@ void Craft::unload()
 	}
 
 	// Remove items
-	for (const auto& pair : *_items->getContents())
+	for (const auto& pair : *_items)
 	{
 		_base->getStorageItems()->addItem(pair.first, pair.second);
 	}
@@ -1818,7 +1827,7 @@ void Craft::reuseItem(const RuleItem* item)
 	// (And we don't want to interrupt any out-of-base status.)
 
 	// The only states we are willing to interrupt are "ready" and "refuelling"
-	if (_status != "STR_READY" && _status != "STR_REFUELLING")
+	if (_status != CRAFT_READY && _status != CRAFT_REFUELLING)
 	{
 		return;
 	}
@@ -1829,17 +1838,17 @@ void Craft::reuseItem(const RuleItem* item)
 		if (cw != 0 && item == cw->getRules()->getClipItem() && cw->getAmmo() < cw->getRules()->getAmmoMax() && !cw->isDisabled())
 		{
 			cw->setRearming(true);
-			_status = "STR_REARMING";
+			_status = CRAFT_REARMING;
 		}
 	}
 
 	// Only consider refuelling if everything else is complete
-	if (_status != "STR_READY")
+	if (_status != CRAFT_READY)
 		return;
 
 	// Check if it's fuel to refuel the craft
 	if (item->getType() == _rules->getRefuelItem() && _fuel < _stats.fuelMax)
-		_status = "STR_REFUELLING";
+		_status = CRAFT_REFUELLING;
 }
 
 /**
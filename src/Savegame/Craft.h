@@ -46,6 +46,12 @@ class ScriptGlobal;
 
 enum UfoDetection : int;
 
+/**
+ * What a craft is busy with, stored in saves by the matching
+ * status string (STR_READY, STR_REFUELLING, ...).
+ */
+enum CraftStatus : int { CRAFT_READY, CRAFT_REFUELLING, CRAFT_REARMING, CRAFT_REPAIRS, CRAFT_OUT };
+
 typedef std::pair<Position, int> SoldierDeploymentData;
 
 struct VehicleDeploymentData
@@ -80,7 +86,7 @@ private:
 	ItemContainer *_items;
 	ItemContainer *_tempSoldierItems;
 	std::vector<Vehicle*> _vehicles;
-	std::string _status;
+	CraftStatus _status;
 	bool _lowFuel, _mission, _inBattlescape, _inDogfight;
 	double _speedMaxRadian;
 	RuleCraftStats _stats;
@@ -99,7 +105,7 @@ private:
 
 public:
 	/// Creates a craft of the specified type.
-	Craft(const RuleCraft *rules, Base *base, int id = 0);
+	Craft(const RuleCraft *rules, const Mod *mod, Base *base, int id = 0);
 	/// Cleans up the craft.
 	~Craft();
 	/// Loads the craft from YAML.
@@ -126,10 +132,12 @@ public:
 	Base *getBase() const;
 	/// Sets the craft's base.
 	void setBase(Base *base, bool move = true);
+	/// Gets the craft's status string.
+	const std::string &getStatus() const;
 	/// Gets the craft's status.
-	std::string getStatus() const;
+	CraftStatus getStatusId() const { return _status; }
 	/// Sets the craft's status.
-	void setStatus(const std::string &status);
+	void setStatus(CraftStatus status);
 	/// Gets the craft's altitude.
 	std::string getAltitude() const;
 	/// Sets the craft's destination.
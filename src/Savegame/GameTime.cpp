@@ -19,6 +19,7 @@
 #include "GameTime.h"
 #include "../Engine/Language.h"
 #include <iomanip>
+#include <cassert>
 
 namespace OpenXcom
 {
@@ -147,6 +148,37 @@ TimeTrigger GameTime::advance()
 	return trigger;
 }
 
+/**
+ * Counts how many times advance() can be called before it
+ * returns anything other than TIME_5SEC, including that call.
+ * Every bigger trigger falls on a 10 minute mark.
+ * @return Number of 5 second steps.
+ */
+int GameTime::getStepsToNextTrigger() const
+{
+	return (60 - _second + 4) / 5 + 12 * (9 - _minute % 10);
+}
+
+/**
+ * Advances the ingame time by several 5 second steps at once,
+ * without sending out any triggers. Must stay short
+ * of the next 10 minute mark.
+ * @param steps Number of steps, less than getStepsToNextTrigger().
+ */
+void GameTime::skip(int steps)
+{
+	assert(steps < getStepsToNextTrigger() && "Skipping over a time trigger.");
+	for (int i = 0; i < steps; ++i)
+	{
+		_second += 5;
+		if (_second >= 60)
+		{
+			_minute++;
+			_second = 0;
+		}
+	}
+}
+
 /**
  * Returns the current ingame second.
  * @return Second (0-59).
@@ -52,6 +52,10 @@ public:
 	bool isLastDayOfMonth();
 	/// Advances the time by 5 seconds.
 	TimeTrigger advance();
+	/// Gets the number of 5 second steps until the next bigger trigger.
+	int getStepsToNextTrigger() const;
+	/// Advances the time by several 5 second steps that fire no bigger trigger.
+	void skip(int steps);
 	/// Gets the ingame second.
 	int getSecond() const;
 	/// Gets the ingame minute.
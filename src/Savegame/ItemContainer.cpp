@@ -17,16 +17,19 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "ItemContainer.h"
+#include <cmath>
 #include "../Mod/Mod.h"
 #include "../Mod/RuleItem.h"
+#include "../Engine/Logger.h"
 
 namespace OpenXcom
 {
 
 /**
  * Initializes an item container with no contents.
+ * @param mod Pointer to mod, turning item types into rule ids.
  */
-ItemContainer::ItemContainer()
+ItemContainer::ItemContainer(const Mod *mod) : _mod(mod), _totalQuantity(0), _totalSize(0), _types(0)
 {
 }
 
@@ -37,13 +40,69 @@ ItemContainer::~ItemContainer()
 {
 }
 
+/**
+ * Looks up the rule id of an item type.
+ * @param id Item ID.
+ * @return Rule id, or -1 for empty or unknown types.
+ */
+int ItemContainer::getRuleId(const std::string &id) const
+{
+	if (Mod::isEmptyRuleName(id))
+	{
+		return -1;
+	}
+	const RuleItem *rule = _mod->getItem(id);
+	return rule ? rule->getRuleId() : -1;
+}
+
+/**
+ * Changes the stored quantity of an item and keeps
+ * the running totals up to date.
+ * @param ruleId Item rule id.
+ * @param qty Quantity to add, negative to remove.
+ */
+void ItemContainer::changeItem(int ruleId, int qty)
+{
+	if ((size_t)ruleId >= _qty.size())
+	{
+		_qty.resize(ruleId + 1, 0);
+	}
+	int &stored = _qty[ruleId];
+	if (stored == 0 && qty != 0)
+	{
+		_types++;
+	}
+	else if (stored != 0 && stored + qty == 0)
+	{
+		_types--;
+	}
+	stored += qty;
+	_totalQuantity += qty;
+	// in millionths, so adding and removing items never drifts
+	_totalSize += std::llround(_mod->getItemById(ruleId)->getSize() * 1000000.0) * qty;
+}
+
 /**
  * Loads the item container from a YAML file.
+ * Unknown item types are logged and dropped.
  * @param node YAML node.
  */
 void ItemContainer::load(const YAML::Node &node)
 {
-	_qty = node.as< std::map<std::string, int> >(_qty);
+	for (YAML::const_iterator i = node.begin(); i != node.end(); ++i)
+	{
+		std::string type = i->first.as<std::string>();
+		int ruleId = getRuleId(type);
+		if (ruleId != -1)
+		{
+			// later entries replace earlier ones, like in a map
+			changeItem(ruleId, i->second.as<int>() - getItem(type));
+		}
+		else
+		{
+			Log(LOG_ERROR) << "Failed to load item " << type;
+		}
+	}
 }
 
 /**
@@ -53,7 +112,10 @@ void ItemContainer::load(const YAML::Node &node)
 YAML::Node ItemContainer::save() const
 {
 	YAML::Node node;
-	node = _qty;
+	for (const auto& pair : *this)
+	{
+		node[pair.first->getType()] = pair.second;
+	}
 	return node;
 }
 
@@ -64,11 +126,15 @@ YAML::Node ItemContainer::save() const
  */
 void ItemContainer::addItem(const std::string &id, int qty)
 {
-	if (Mod::isEmptyRuleName(id))
+	int ruleId = getRuleId(id);
+	if (ruleId != -1)
 	{
-		return;
+		changeItem(ruleId, qty);
+	}
+	else if (!Mod::isEmptyRuleName(id))
+	{
+		Log(LOG_ERROR) << "Unknown item " << id;
 	}
-	_qty[id] += qty;
 }
 
 /**
@@ -80,7 +146,7 @@ void ItemContainer::addItem(const RuleItem* item, int qty)
 {
 	if (item)
 	{
-		addItem(item->getType(), qty);
+		changeItem(item->getRuleId(), qty);
 	}
 }
 
@@ -95,24 +161,12 @@ void ItemContainer::removeItem(const std::string &id, int qty)
 	{
 		return;
 	}
-	auto it = _qty.find(id);
-	if (it == _qty.end())
-	{
-		return;
-	}
-
-	if (qty < it->second)
-	{
-		it->second -= qty;
-	}
-	else
-	{
-		_qty.erase(it);
-	}
+	removeItem(_mod->getItem(id), qty);
 }
 
 /**
  * Removes an item amount from the container.
+ * Removing more than there is leaves none.
  * @param id Item ID.
  * @param qty Item quantity.
  */
@@ -120,7 +174,11 @@ void ItemContainer::removeItem(const RuleItem* item, int qty)
 {
 	if (item)
 	{
-		removeItem(item->getType(), qty);
+		int stored = getItem(item);
+		if (stored != 0)
+		{
+			changeItem(item->getRuleId(), qty < stored ? -qty : -stored);
+		}
 	}
 }
 
@@ -135,16 +193,7 @@ int ItemContainer::getItem(const std::string &id) const
 	{
 		return 0;
 	}
-
-	auto it = _qty.find(id);
-	if (it == _qty.end())
-	{
-		return 0;
-	}
-	else
-	{
-		return it->second;
-	}
+	return getItem(_mod->getItem(id));
 }
 
 /**
@@ -154,9 +203,9 @@ int ItemContainer::getItem(const std::string &id) const
  */
 int ItemContainer::getItem(const RuleItem* item) const
 {
-	if (item)
+	if (item && (size_t)item->getRuleId() < _qty.size())
 	{
-		return getItem(item->getType());
+		return _qty[item->getRuleId()];
 	}
 	else
 	{
@@ -165,41 +214,34 @@ int ItemContainer::getItem(const RuleItem* item) const
 }
 
 /**
- * Returns the total quantity of the items in the container.
- * @return Total item quantity.
+ * Removes all the items from the container.
  */
-int ItemContainer::getTotalQuantity() const
+void ItemContainer::clear()
 {
-	int total = 0;
-	for (const auto& pair : _qty)
-	{
-		total += pair.second;
-	}
-	return total;
+	_qty.clear();
+	_totalQuantity = 0;
+	_totalSize = 0;
+	_types = 0;
 }
 
 /**
- * Returns the total size of the items in the container.
- * @param mod Pointer to mod.
- * @return Total item size.
+ * Moves the iterator past the item types not in the container.
  */
-double ItemContainer::getTotalSize(const Mod *mod) const
+void ItemContainer::const_iterator::skipEmpty()
 {
-	double total = 0;
-	for (const auto& pair : _qty)
+	while (_index < _container->_qty.size() && _container->_qty[_index] == 0)
 	{
-		total += mod->getItem(pair.first, true)->getSize() * pair.second;
+		++_index;
 	}
-	return total;
 }
 
 /**
- * Returns all the items currently contained within.
- * @return List of contents.
+ * Gets the item the iterator is at.
+ * @return Item rule and quantity.
  */
-std::map<std::string, int> *ItemContainer::getContents()
+std::pair<RuleItem*, int> ItemContainer::const_iterator::operator*() const
 {
-	return &_qty;
+	return std::make_pair(_container->_mod->getItemById(_index), _container->_qty[_index]);
 }
 
 }
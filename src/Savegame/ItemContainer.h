@@ -18,7 +18,9 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <string>
-#include <map>
+#include <vector>
+#include <utility>
+#include <stdint.h>
 #include <yaml-cpp/yaml.h>
 
 namespace OpenXcom
@@ -31,14 +33,46 @@ class RuleItem;
  * Represents the items contained by a certain entity,
  * like base stores, craft equipment, etc.
  * Handles all necessary item management tasks.
+ * Quantities are kept in an array indexed by item rule id,
+ * together with running totals, so lookups and totals are O(1).
  */
 class ItemContainer
 {
 private:
-	std::map<std::string, int> _qty;
+	const Mod *_mod;
+	std::vector<int> _qty;
+	int _totalQuantity;
+	int64_t _totalSize;
+	int _types;
+
+	/// Gets the rule id of an item type.
+	int getRuleId(const std::string &id) const;
+	/// Changes the quantity of an item.
+	void changeItem(int ruleId, int qty);
 public:
+	/**
+	 * Walks the items in the container ordered by type,
+	 * giving the item rule and quantity of each.
+	 * Items can be added or removed while walking.
+	 */
+	class const_iterator
+	{
+	private:
+		const ItemContainer *_container;
+		size_t _index;
+		void skipEmpty();
+	public:
+		const_iterator(const ItemContainer *container, size_t index) : _container(container), _index(index) { skipEmpty(); }
+		std::pair<RuleItem*, int> operator*() const;
+		const_iterator &operator++() { ++_index; skipEmpty(); return *this; }
+		bool operator==(const const_iterator &other) const { return atEnd() == other.atEnd() && (atEnd() || _index == other._index); }
+		bool operator!=(const const_iterator &other) const { return !(*this == other); }
+		/// Checks if the iterator is past the last item, the container can shrink while walking.
+		bool atEnd() const { return _index >= _container->_qty.size(); }
+	};
+
 	/// Creates an empty item container.
-	ItemContainer();
+	ItemContainer(const Mod *mod);
 	/// Cleans up the item container.
 	~ItemContainer();
 	/// Loads the item container from YAML.
@@ -58,11 +92,17 @@ public:
 	/// Gets an item in the container.
 	int getItem(const RuleItem* item) const;
 	/// Gets the total quantity of items in the container.
-	int getTotalQuantity() const;
+	int getTotalQuantity() const { return _totalQuantity; }
 	/// Gets the total size of items in the container.
-	double getTotalSize(const Mod *mod) const;
-	/// Gets all the items in the container.
-	std::map<std::string, int> *getContents();
+	double getTotalSize() const { return _totalSize / 1000000.0; }
+	/// Checks if the container has no items.
+	bool empty() const { return _types == 0; }
+	/// Removes all the items from the container.
+	void clear();
+	/// Gets the first item in the container.
+	const_iterator begin() const { return const_iterator(this, 0); }
+	/// Gets the end of the items in the container.
+	const_iterator end() const { return const_iterator(this, _qty.size()); }
 };
 
 }
@@ -0,0 +1,156 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "NodeIndex.h"
+#include <algorithm>
+#include "Node.h"
+#include "../fmath.h"
+
+namespace OpenXcom
+{
+
+namespace
+{
+
+/// Width of a cell in tiles, the size of a map block.
+const int NodeCellSize = 10;
+
+/// Empty list for ranks no node has.
+const std::vector<int> NoNodes;
+
+}
+
+/**
+ * Creates an empty index for an empty map.
+ */
+NodeIndex::NodeIndex() : _cellsX(0), _cellsY(0), _levels(0), _indexed(0)
+{
+}
+
+/**
+ * Removes all the nodes, for a new map.
+ * @param mapSizeX Map width in tiles.
+ * @param mapSizeY Map length in tiles.
+ * @param mapSizeZ Map height in levels.
+ */
+void NodeIndex::reset(int mapSizeX, int mapSizeY, int mapSizeZ)
+{
+	_cellsX = std::max(1, (mapSizeX + NodeCellSize - 1) / NodeCellSize);
+	_cellsY = std::max(1, (mapSizeY + NodeCellSize - 1) / NodeCellSize);
+	_levels = std::max(1, mapSizeZ);
+	_indexed = 0;
+	_cells.clear();
+	_cells.resize(_cellsX * _cellsY * _levels);
+	_ranks.clear();
+}
+
+/**
+ * Gets the cell a position falls in, positions off the map go to the nearest one.
+ * @param x X position in tiles.
+ * @param y Y position in tiles.
+ * @param z Level.
+ * @return Cell index.
+ */
+int NodeIndex::getCell(int x, int y, int z) const
+{
+	x = Clamp(x / NodeCellSize, 0, _cellsX - 1);
+	y = Clamp(y / NodeCellSize, 0, _cellsY - 1);
+	z = Clamp(z, 0, _levels - 1);
+	return (z * _cellsY + y) * _cellsX + x;
+}
+
+/**
+ * Adds the nodes that were added to the list since the last update.
+ * Nodes are only ever added at the end of the list, until reset() is called.
+ * @param nodes List of all the nodes of the battle.
+ */
+void NodeIndex::update(const std::vector<Node*> &nodes)
+{
+	for (; _indexed < nodes.size(); ++_indexed)
+	{
+		const Node *node = nodes[_indexed];
+		if (node->isDummy())
+		{
+			continue;
+		}
+		Position pos = node->getPosition();
+		_cells[getCell(pos.x, pos.y, pos.z)].push_back(_indexed);
+		size_t rank = node->getRank();
+		if (rank >= _ranks.size())
+		{
+			_ranks.resize(rank + 1);
+		}
+		_ranks[rank].push_back(_indexed);
+	}
+}
+
+/**
+ * Gets all the nodes of a rank.
+ * @param rank Node rank.
+ * @return List of node indices, in the order of the node list.
+ */
+const std::vector<int> &NodeIndex::getRank(int rank) const
+{
+	if (rank < 0 || (size_t)rank >= _ranks.size())
+	{
+		return NoNodes;
+	}
+	return _ranks[rank];
+}
+
+/**
+ * Gets all the nodes that might be within a horizontal distance of a position.
+ * Every node that really is in range is returned, along with
+ * some that aren't, so callers still need to check the distance.
+ * @param center Position to search around.
+ * @param radius Distance in tiles.
+ * @param sameLevel Only look on the level of the position.
+ * @param result List to fill with node indices, in the order of the node list.
+ */
+void NodeIndex::query(Position center, int radius, bool sameLevel, std::vector<int> &result) const
+{
+	result.clear();
+	if (_cells.empty())
+	{
+		return;
+	}
+	int firstLevel = sameLevel ? center.z : 0;
+	int lastLevel = sameLevel ? center.z : _levels - 1;
+	if (firstLevel < 0 || lastLevel >= _levels)
+	{
+		return;
+	}
+	int firstX = Clamp((center.x - radius) / NodeCellSize, 0, _cellsX - 1);
+	int lastX = Clamp((center.x + radius) / NodeCellSize, 0, _cellsX - 1);
+	int firstY = Clamp((center.y - radius) / NodeCellSize, 0, _cellsY - 1);
+	int lastY = Clamp((center.y + radius) / NodeCellSize, 0, _cellsY - 1);
+	for (int z = firstLevel; z <= lastLevel; ++z)
+	{
+		for (int y = firstY; y <= lastY; ++y)
+		{
+			for (int x = firstX; x <= lastX; ++x)
+			{
+				const auto& cell = _cells[(z * _cellsY + y) * _cellsX + x];
+				result.insert(result.end(), cell.begin(), cell.end());
+			}
+		}
+	}
+	std::sort(result.begin(), result.end());
+}
+
+}
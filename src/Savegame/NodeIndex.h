@@ -0,0 +1,59 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <vector>
+#include "../Battlescape/Position.h"
+
+namespace OpenXcom
+{
+
+class Node;
+
+/**
+ * Buckets the route nodes of a battle by rank and by map block sized
+ * cells on every level, so the AI and spawning only have to look at
+ * the nodes that can match.
+ * Nodes are identified by their index in the node list, dummies are left out.
+ */
+class NodeIndex
+{
+private:
+	int _cellsX, _cellsY, _levels;
+	size_t _indexed;
+	/// Indices of the nodes in each cell.
+	std::vector<std::vector<int> > _cells;
+	/// Indices of the nodes of each rank.
+	std::vector<std::vector<int> > _ranks;
+
+	/// Gets the cell of a position.
+	int getCell(int x, int y, int z) const;
+public:
+	/// Creates an empty index.
+	NodeIndex();
+	/// Empties the index and sets the size of the map.
+	void reset(int mapSizeX, int mapSizeY, int mapSizeZ);
+	/// Adds the nodes that are not indexed yet.
+	void update(const std::vector<Node*> &nodes);
+	/// Gets the nodes of a rank.
+	const std::vector<int> &getRank(int rank) const;
+	/// Gets the nodes that can be within a distance of a position.
+	void query(Position center, int radius, bool sameLevel, std::vector<int> &result) const;
+};
+
+}
@@ -154,7 +154,7 @@ void SaveConverter::getList(Language *lang, SaveOriginal info[NUM_SAVES])
  */
 SavedGame *SaveConverter::loadOriginal()
 {
-	_save = new SavedGame();
+	_save = new SavedGame(_mod);
 
 	// Load globe data
 	_save->getIncomes().clear();
@@ -648,7 +648,7 @@ void SaveConverter::loadDatLoc()
 			target = ufo;
 			break;
 		case TARGET_CRAFT:
-			craft = new Craft(_mod->getCraft(_rules->getCrafts()[0], true), 0, id);
+			craft = new Craft(_mod->getCraft(_rules->getCrafts()[0], true), _mod, 0, id);
 			target = craft;
 			break;
 		case TARGET_XBASE:
@@ -742,6 +742,7 @@ void SaveConverter::loadDatBase()
 					base->getFacilities()->push_back(facility);
 				}
 			}
+			base->updateCapacity();
 			int engineers = load<Uint8>(bdata + _rules->getOffset("BASE.DAT_ENGINEERS"));
 			int scientists = load<Uint8>(bdata + _rules->getOffset("BASE.DAT_SCIENTISTS"));
 			// items
@@ -832,7 +833,7 @@ void SaveConverter::loadDatTransfer()
 				if (baseSrc == 255)
 				{
 					std::string newCraft = _rules->getCrafts()[dat];
-					transfer->setCraft(new Craft(_mod->getCraft(newCraft, true), b, _save->getId(newCraft)));
+					transfer->setCraft(new Craft(_mod->getCraft(newCraft, true), _mod, b, _save->getId(newCraft)));
 				}
 				else
 				{
@@ -27,6 +27,7 @@
 #include "Tile.h"
 #include "HitLog.h"
 #include "Node.h"
+#include "NodeIndex.h"
 #include "../Mod/MapDataSet.h"
 #include "../Battlescape/Pathfinding.h"
 #include "../Battlescape/TileEngine.h"
@@ -63,7 +64,7 @@ namespace OpenXcom
 SavedBattleGame::SavedBattleGame(Mod *rule, Language *lang, bool isPreview) :
 	_isPreview(isPreview), _craftPos(), _craftZ(0), _craftForPreview(nullptr),
 	_battleState(0), _rule(rule), _mapsize_x(0), _mapsize_y(0), _mapsize_z(0), _selectedUnit(0),
-	_lastSelectedUnit(0), _pathfinding(0), _tileEngine(0),
+	_lastSelectedUnit(0), _nodeIndex(new NodeIndex()), _pathfinding(0), _tileEngine(0),
 	_reinforcementsItemLevel(0), _startingCondition(nullptr), _enviroEffects(nullptr), _ecEnabledFriendly(false), _ecEnabledHostile(false), _ecEnabledNeutral(false),
 	_globalShade(0), _side(FACTION_PLAYER), _turn(0), _bughuntMinTurn(20), _animFrame(0), _nameDisplay(false),
 	_debugMode(false), _bughuntMode(false), _aborted(false), _itemId(0),
@@ -80,7 +81,7 @@ SavedBattleGame::SavedBattleGame(Mod *rule, Language *lang, bool isPreview) :
 		_tileSearch[i].x = ((i%11) - 5);
 		_tileSearch[i].y = ((i/11) - 5);
 	}
-	_baseItems = new ItemContainer();
+	_baseItems = new ItemContainer(rule);
 	_hitLog = new HitLog(lang);
 
 	setRandomHiddenMovementBackground(0);
@@ -91,10 +92,7 @@ SavedBattleGame::SavedBattleGame(Mod *rule, Language *lang, bool isPreview) :
  */
 SavedBattleGame::~SavedBattleGame()
 {
-	for (auto* mds : _mapDataSets)
-	{
-		mds->unloadData();
-	}
+	// terrain data stays loaded for the next mission, the mod unloads it
 	for (auto* node : _nodes)
 	{
 		delete node;
@@ -119,6 +117,7 @@ SavedBattleGame::~SavedBattleGame()
 	{
 		delete bi;
 	}
+	delete _nodeIndex;
 	delete _pathfinding;
 	delete _tileEngine;
 	delete _baseItems;
@@ -690,9 +689,11 @@ void SavedBattleGame::initMap(int mapsize_x, int mapsize_y, int mapsize_z, bool
 	_mapsize_x = mapsize_x;
 	_mapsize_y = mapsize_y;
 	_mapsize_z = mapsize_z;
+	_nodeIndex->reset(mapsize_x, mapsize_y, mapsize_z);
 
 	_tiles.clear();
 	_tiles.reserve(_mapsize_z * _mapsize_y * _mapsize_x);
+	_tileHot.reset(_mapsize_z * _mapsize_y * _mapsize_x);
 	for (int i = 0; i < _mapsize_z * _mapsize_y * _mapsize_x; ++i)
 	{
 		_tiles.push_back(Tile(getTileCoords(i), this));
@@ -1032,6 +1033,16 @@ std::vector<Node*> *SavedBattleGame::getNodes()
 	return &_nodes;
 }
 
+/**
+ * Gets the index of the nodes, with any nodes added since the last call.
+ * @return Index of the nodes by rank and position.
+ */
+const NodeIndex &SavedBattleGame::getNodeIndex()
+{
+	_nodeIndex->update(_nodes);
+	return *_nodeIndex;
+}
+
 /**
  * Gets the list of units.
  * @return Pointer to the list of units.
@@ -2207,14 +2218,10 @@ Node *SavedBattleGame::getSpawnNode(int nodeRank, BattleUnit *unit)
 	int highestPriority = -1;
 	std::vector<Node*> compliantNodes;
 
-	for (auto* node : *getNodes())
+	for (int i : getNodeIndex().getRank(nodeRank))					// ranks must match
 	{
-		if (node->isDummy())
-		{
-			continue;
-		}
-		if (node->getRank() == nodeRank								// ranks must match
-			&& (!(node->getType() & Node::TYPE_SMALL)
+		Node *node = _nodes[i];
+		if ((!(node->getType() & Node::TYPE_SMALL)
 				|| unit->isSmallUnit())								// the small unit bit is not set or the unit is small
 			&& (!(node->getType() & Node::TYPE_FLYING)
 				|| unit->getMovementType() == MT_FLY)				// the flying unit bit is not set or the unit can fly
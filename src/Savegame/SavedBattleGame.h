@@ -31,6 +31,7 @@ class Tile;
 class SavedGame;
 class MapDataSet;
 class Node;
+class NodeIndex;
 class BattlescapeState;
 class BattlescapeGame;
 class Position;
@@ -73,8 +74,10 @@ private:
 	int _mapsize_x, _mapsize_y, _mapsize_z;
 	std::vector<MapDataSet*> _mapDataSets;
 	std::vector<Tile> _tiles;
+	TileHotData _tileHot;
 	BattleUnit *_selectedUnit, *_lastSelectedUnit;
 	std::vector<Node*> _nodes;
+	NodeIndex *_nodeIndex;
 	std::vector<BattleUnit*> _units;
 	std::vector<BattleItem*> _items, _deleted;
 	Pathfinding *_pathfinding;
@@ -214,6 +217,8 @@ public:
 	int getGlobalShade() const;
 	/// Gets a pointer to the list of nodes.
 	std::vector<Node*> *getNodes();
+	/// Gets the index of the nodes by rank and position.
+	const NodeIndex &getNodeIndex();
 	/// Gets a pointer to the list of items.
 	std::vector<BattleItem*> *getItems();
 	/// Gets a pointer to the list of units.
@@ -288,6 +293,11 @@ public:
 		return &_tiles[getTileIndex(pos)];
 	}
 
+	/// Gets hot tile fields mirrored in contiguous arrays, indexed by `getTileIndex`.
+	TileHotData& getTileHotData() { return _tileHot; }
+	/// Gets hot tile fields mirrored in contiguous arrays, indexed by `getTileIndex`.
+	const TileHotData& getTileHotData() const { return _tileHot; }
+
 	/*
 	 * Gets a pointer to the tiles, a tile is the smallest component of battlescape.
 	 * @param pos Index position, less than `getMapSizeXYZ()`.
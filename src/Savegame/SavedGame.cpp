@@ -142,10 +142,11 @@ bool haveReserchVector(const std::vector<const RuleResearch*> &vec,  const std::
 
 /**
  * Initializes a brand new saved game according to the specified difficulty.
+ * @param mod Pointer to mod.
  */
-SavedGame::SavedGame() :
+SavedGame::SavedGame(const Mod *mod) :
 	_difficulty(DIFF_BEGINNER), _end(END_NONE), _ironman(false), _globeLon(0.0), _globeLat(0.0), _globeZoom(0),
-	_battleGame(0), _previewBase(nullptr), _debug(false), _warned(false),
+	_battleGame(0), _researchIndexMod(nullptr), _previewBase(nullptr), _debug(false), _warned(false),
 	_togglePersonalLight(true), _toggleNightVision(false), _toggleBrightness(0),
 	_monthsPassed(-1), _selectedBase(0), _autosales(), _disableSoldierEquipment(false), _alienContainmentChecked(false)
 {
@@ -160,7 +161,7 @@ SavedGame::SavedGame() :
 
 	for (int j = 0; j < MAX_CRAFT_LOADOUT_TEMPLATES; ++j)
 	{
-		_globalCraftLoadout[j] = new ItemContainer();
+		_globalCraftLoadout[j] = new ItemContainer(mod);
 	}
 }
 
@@ -604,6 +605,7 @@ void SavedGame::load(const std::string &filename, Mod *mod, Language *lang)
 		}
 	}
 	sortReserchVector(_discovered);
+	updateResearchIndex(mod);
 
 	_generatedEvents = doc["generatedEvents"].as< std::map<std::string, int> >(_generatedEvents);
 	_ufopediaRuleStatus = doc["ufopediaRuleStatus"].as< std::map<std::string, int> >(_ufopediaRuleStatus);
@@ -964,7 +966,7 @@ void SavedGame::save(const std::string &filename, Mod *mod) const
 		std::ostringstream oss;
 		oss << "globalCraftLoadout" << j;
 		std::string key = oss.str();
-		if (!_globalCraftLoadout[j]->getContents()->empty())
+		if (!_globalCraftLoadout[j]->empty())
 		{
 			node[key] = _globalCraftLoadout[j]->save();
 		}
@@ -1597,6 +1599,10 @@ void SavedGame::removeDiscoveredResearch(const RuleResearch * research)
 	if (r != _discovered.end())
 	{
 		_discovered.erase(r);
+		if (!haveReserchVector(_discovered, research))
+		{
+			updateResearchDiscovered(research, -1);
+		}
 	}
 }
 
@@ -1606,8 +1612,136 @@ void SavedGame::removeDiscoveredResearch(const RuleResearch * research)
  */
 void SavedGame::addFinishedResearchSimple(const RuleResearch * research)
 {
+	bool known = isDiscovered(research);
 	_discovered.push_back(research);
 	sortReserchVector(_discovered);
+	if (!known)
+	{
+		updateResearchDiscovered(research, +1);
+	}
+}
+
+/**
+ * Builds the index used to find the available research topics
+ * without going through the whole research list every time.
+ * For each topic it counts the undiscovered dependencies and
+ * requirements and the discovered topics unlocking it,
+ * and remembers which topics depend on which.
+ * Topics are indexed by their rule id.
+ * Does nothing if the index is already built for this mod
+ * or the mod has not handed out rule ids yet.
+ * @param mod the game Mod
+ */
+void SavedGame::updateResearchIndex(const Mod *mod)
+{
+	if (_researchIndexMod == mod || mod->getResearchIdCount() == 0)
+	{
+		return;
+	}
+	_researchIndexMod = mod;
+	const int count = mod->getResearchIdCount();
+	_researchCandidates.clear();
+	_researchDependents.assign(count, std::vector<int>());
+	_researchRequirers.assign(count, std::vector<int>());
+	_researchAvailability.assign(count, ResearchAvailability());
+
+	for (int id = 0; id < count; ++id)
+	{
+		const RuleResearch *research = mod->getResearchById(id);
+		ResearchAvailability &availability = _researchAvailability[id];
+		for (const auto* dep : research->getDependencies())
+		{
+			_researchDependents[dep->getRuleId()].push_back(id);
+			if (!haveReserchVector(_discovered, dep))
+			{
+				availability.missingDependencies++;
+			}
+		}
+		for (const auto* req : research->getRequirements())
+		{
+			_researchRequirers[req->getRuleId()].push_back(id);
+			if (!haveReserchVector(_discovered, req))
+			{
+				availability.missingRequirements++;
+			}
+		}
+	}
+	for (auto it = _discovered.begin(); it != _discovered.end(); it = std::upper_bound(it, _discovered.end(), *it, researchLess))
+	{
+		_researchAvailability[(*it)->getRuleId()].discovered = true;
+		for (const auto* unl : (*it)->getUnlocked())
+		{
+			_researchAvailability[unl->getRuleId()].unlockedBy++;
+		}
+	}
+	for (int id = 0; id < count; ++id)
+	{
+		updateResearchCandidate(id);
+	}
+}
+
+/**
+ * Updates the counters of all topics related to a topic
+ * that just became discovered or undiscovered.
+ * @param research The topic.
+ * @param change +1 when discovered, -1 when forgotten.
+ */
+void SavedGame::updateResearchDiscovered(const RuleResearch *research, int change)
+{
+	if (_researchIndexMod == nullptr)
+	{
+		return;
+	}
+	const int id = research->getRuleId();
+	_researchAvailability[id].discovered = change > 0;
+	for (int dependent : _researchDependents[id])
+	{
+		_researchAvailability[dependent].missingDependencies -= change;
+		updateResearchCandidate(dependent);
+	}
+	for (int requirer : _researchRequirers[id])
+	{
+		_researchAvailability[requirer].missingRequirements -= change;
+		updateResearchCandidate(requirer);
+	}
+	for (const auto* unl : research->getUnlocked())
+	{
+		_researchAvailability[unl->getRuleId()].unlockedBy += change;
+		updateResearchCandidate(unl->getRuleId());
+	}
+}
+
+/**
+ * Keeps a topic on the candidate list while its dependencies
+ * (or an unlock) and its requirements are all discovered.
+ * @param id Rule id of the topic.
+ */
+void SavedGame::updateResearchCandidate(int id)
+{
+	const ResearchAvailability &availability = _researchAvailability[id];
+	if ((availability.unlockedBy > 0 || availability.missingDependencies == 0) && availability.missingRequirements == 0)
+	{
+		_researchCandidates.insert(id);
+	}
+	else
+	{
+		_researchCandidates.erase(id);
+	}
+}
+
+/**
+ * Checks if a topic is on the discovered list,
+ * in constant time once the research index is built.
+ * @param research The topic.
+ * @return True if discovered.
+ */
+bool SavedGame::isDiscovered(const RuleResearch *research) const
+{
+	if (_researchIndexMod != nullptr)
+	{
+		return _researchAvailability[research->getRuleId()].discovered;
+	}
+	return haveReserchVector(_discovered, research);
 }
 
 /**
@@ -1619,6 +1753,8 @@ void SavedGame::addFinishedResearchSimple(const RuleResearch * research)
  */
 void SavedGame::addFinishedResearch(const RuleResearch * research, const Mod * mod, Base * base, bool score)
 {
+	updateResearchIndex(mod);
+
 	// process "re-enables"
 	for (const auto* ree : research->getReenabled())
 	{
@@ -1650,8 +1786,7 @@ void SavedGame::addFinishedResearch(const RuleResearch * research, const Mod * m
 		bool checkRelatedZeroCostTopics = true;
 		if (!isResearched(currentQueueItem, false))
 		{
-			_discovered.push_back(currentQueueItem);
-			sortReserchVector(_discovered);
+			addFinishedResearchSimple(currentQueueItem);
 			if (!hasUndiscoveredProtectedUnlocks && !hasAnyUndiscoveredGetOneFrees)
 			{
 				// If the currentQueueItem can't tell you anything anymore, remove it from popped research
@@ -1764,6 +1899,20 @@ const std::vector<const RuleResearch *> & SavedGame::getDiscoveredResearch() con
  */
 void SavedGame::getAvailableResearchProjects(std::vector<RuleResearch *> &projects, const Mod *mod, Base *base, bool considerDebugMode) const
 {
+	// The index only has the topics with discovered dependencies and requirements, no need to check the rest
+	if (_researchIndexMod == mod && !(considerDebugMode && _debug))
+	{
+		for (int id : _researchCandidates)
+		{
+			RuleResearch *research = mod->getResearchById(id);
+			if (!isResearchRuleStatusDisabled(research->getName()) && isResearchAvailable(research, mod, base))
+			{
+				projects.push_back(research);
+			}
+		}
+		return;
+	}
+
 	// This list is used for topics that can be researched even if *not all* dependencies have been discovered yet (e.g. STR_ALIEN_ORIGINS)
 	// Note: all requirements of such topics *have to* be discovered though! This will be handled elsewhere.
 	std::vector<const RuleResearch *> unlocked;
@@ -1773,8 +1922,8 @@ void SavedGame::getAvailableResearchProjects(std::vector<RuleResearch *> &projec
 		{
 			unlocked.push_back(unl);
 		}
-		sortReserchVector(unlocked);
 	}
+	sortReserchVector(unlocked);
 
 	// Create a list of research topics available for research in the given base
 	for (const auto& pair : mod->getResearchMap())
@@ -1811,57 +1960,73 @@ void SavedGame::getAvailableResearchProjects(std::vector<RuleResearch *> &projec
 			continue;
 		}
 
-		// Remove the already researched topics from the list *UNLESS* they can still give you something more
-		if (isResearched(research->getName(), false))
+		if (isResearchAvailable(research, mod, base))
 		{
-			if (hasUndiscoveredGetOneFree(research, true))
-			{
-				// This research topic still has some more undiscovered non-disabled and *AVAILABLE* "getOneFree" topics, keep it!
-			}
-			else if (hasUndiscoveredProtectedUnlock(research, mod))
-			{
-				// This research topic still has one or more undiscovered non-disabled "protected unlocks", keep it!
-			}
-			else
-			{
-				// This topic can't give you anything else anymore, ignore it!
-				continue;
-			}
+			projects.push_back(research);
 		}
+	}
+}
 
-		if (base)
+/**
+ * Checks the rest of the conditions for a research topic
+ * whose dependencies and requirements are already satisfied.
+ * @param research The research topic.
+ * @param mod the game Mod
+ * @param base a pointer to a Base
+ * @return True if the topic can be researched in the base.
+ */
+bool SavedGame::isResearchAvailable(RuleResearch *research, const Mod *mod, Base *base) const
+{
+	// Remove the already researched topics from the list *UNLESS* they can still give you something more
+	if (isResearched(research, false))
+	{
+		if (hasUndiscoveredGetOneFree(research, true))
 		{
-			// Check if this topic is already being researched in the given base
-			const std::vector<ResearchProject *> & baseResearchProjects = base->getResearch();
-			if (std::find_if(baseResearchProjects.begin(), baseResearchProjects.end(), findRuleResearch(research)) != baseResearchProjects.end())
-			{
-				continue;
-			}
-
-			// Check for needed item in the given base
-			if (research->needItem() && base->getStorageItems()->getItem(research->getName()) == 0)
-			{
-				continue;
-			}
-
-			// Check for required buildings/functions in the given base
-			if ((~base->getProvidedBaseFunc({}) & research->getRequireBaseFunc()).any())
-			{
-				continue;
-			}
+			// This research topic still has some more undiscovered non-disabled and *AVAILABLE* "getOneFree" topics, keep it!
+		}
+		else if (hasUndiscoveredProtectedUnlock(research, mod))
+		{
+			// This research topic still has one or more undiscovered non-disabled "protected unlocks", keep it!
 		}
 		else
 		{
-			// Used in vanilla save converter only
-			if (research->needItem() && research->getCost() == 0)
-			{
-				continue;
-			}
+			// This topic can't give you anything else anymore, ignore it!
+			return false;
+		}
+	}
+
+	if (base)
+	{
+		// Check if this topic is already being researched in the given base
+		const std::vector<ResearchProject *> & baseResearchProjects = base->getResearch();
+		if (std::find_if(baseResearchProjects.begin(), baseResearchProjects.end(), findRuleResearch(research)) != baseResearchProjects.end())
+		{
+			return false;
+		}
+
+		// Check for needed item in the given base
+		if (research->needItem() && base->getStorageItems()->getItem(research->getName()) == 0)
+		{
+			return false;
 		}
 
-		// Hallelujah, all checks passed, add the research topic to the list
-		projects.push_back(research);
+		// Check for required buildings/functions in the given base
+		if ((~base->getProvidedBaseFunc({}) & research->getRequireBaseFunc()).any())
+		{
+			return false;
+		}
+	}
+	else
+	{
+		// Used in vanilla save converter only
+		if (research->needItem() && research->getCost() == 0)
+		{
+			return false;
+		}
 	}
+
+	// Hallelujah, all checks passed
+	return true;
 }
 
 /**
@@ -2192,7 +2357,7 @@ bool SavedGame::isResearched(const RuleResearch *research, bool considerDebugMod
 	if (considerDebugMode && _debug)
 		return true;
 
-	return haveReserchVector(_discovered, research);
+	return isDiscovered(research);
 }
 
 bool SavedGame::isResearched(const std::vector<std::string> &research, bool considerDebugMode) const
@@ -2245,7 +2410,7 @@ bool SavedGame::isResearched(const std::vector<const RuleResearch *> &research,
 
 	for (const auto* res : matches)
 	{
-		if (!haveReserchVector(_discovered, res))
+		if (!isDiscovered(res))
 		{
 			return false;
 		}
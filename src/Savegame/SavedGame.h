@@ -95,6 +95,18 @@ struct SaveInfo
 	bool reserved;
 };
 
+/**
+ * How far a research topic is from becoming available,
+ * kept up to date as topics get discovered.
+ */
+struct ResearchAvailability
+{
+	int missingDependencies = 0;
+	int missingRequirements = 0;
+	int unlockedBy = 0;
+	bool discovered = false;
+};
+
 /**
  * The game data that gets written to disk when the game is saved.
  * A saved game holds all the variable info in a game like funds,
@@ -141,6 +153,10 @@ private:
 	AlienStrategy *_alienStrategy;
 	SavedBattleGame *_battleGame;
 	std::vector<const RuleResearch*> _discovered;
+	const Mod *_researchIndexMod;
+	std::vector<std::vector<int> > _researchDependents, _researchRequirers;
+	std::vector<ResearchAvailability> _researchAvailability;
+	std::set<int> _researchCandidates;
 	std::map<std::string, int> _generatedEvents;
 	std::map<std::string, int> _ufopediaRuleStatus;
 	std::map<std::string, int> _manufactureRuleStatus;
@@ -175,10 +191,18 @@ private:
 	ScriptValues<SavedGame> _scriptValues;
 
 	static SaveInfo getSaveInfo(const std::string &file, Language *lang);
+	/// Updates the index after a topic got discovered or forgotten.
+	void updateResearchDiscovered(const RuleResearch *research, int change);
+	/// Moves a topic in or out of the available candidates.
+	void updateResearchCandidate(int id);
+	/// Checks if a topic is on the discovered list.
+	bool isDiscovered(const RuleResearch *research) const;
+	/// Checks the per base conditions of an available topic.
+	bool isResearchAvailable(RuleResearch *research, const Mod *mod, Base *base) const;
 public:
 	static const std::string AUTOSAVE_GEOSCAPE, AUTOSAVE_BATTLESCAPE, QUICKSAVE;
 	/// Creates a new saved game.
-	SavedGame();
+	SavedGame(const Mod *mod);
 	/// Cleans up the saved game.
 	~SavedGame();
 	/// Sanitizes a mod name in a save.
@@ -281,6 +305,8 @@ public:
 	const RuleResearch* selectGetOneFree(const RuleResearch* research);
 	/// Remove a research from the "already discovered" list
 	void removeDiscoveredResearch(const RuleResearch *research);
+	/// Rebuilds the research availability index for a mod.
+	void updateResearchIndex(const Mod *mod);
 	/// Add a finished ResearchProject
 	void addFinishedResearchSimple(const RuleResearch *research);
 	/// Add a finished ResearchProject
@@ -55,7 +55,7 @@ Soldier::Soldier(RuleSoldier *rules, Armor *armor, int nationality, int id) :
 	_gender(GENDER_MALE), _look(LOOK_BLONDE), _lookVariant(0), _missions(0), _kills(0), _stuns(0),
 	_recentlyPromoted(false), _psiTraining(false), _training(false), _returnToTrainingWhenHealed(false),
 	_armor(armor), _replacedArmor(0), _transformedArmor(0), _personalEquipmentArmor(nullptr), _death(0), _diary(new SoldierDiary()),
-	_corpseRecovered(false)
+	_corpseRecovered(false), _tmpStatsArmor(nullptr), _tmpStatsMod(nullptr), _tmpStatsBonusKey(0), _tmpStatsHasSoldierBonus(false)
 {
 	if (id != 0)
 	{
@@ -739,6 +739,7 @@ void Soldier::promoteRank()
 	}
 
 	_rank = (SoldierRank)((int)_rank + 1);
+	resetStatsWithBonuses();
 	if (_rank > RANK_SQUADDIE)
 	{
 		// only promotions above SQUADDIE are worth to be mentioned
@@ -765,6 +766,7 @@ void Soldier::setRank(const SoldierRank newRank)
 	}
 
 	_rank = newRank;
+	resetStatsWithBonuses();
 
 	// Note: we don't need to show a notification for this style of promotion
 }
@@ -1334,8 +1336,9 @@ std::vector<EquipmentLayoutItem*> *Soldier::getEquipmentLayout()
 
 /**
  * Trains a soldier's Psychic abilities after 1 month.
+ * @param rng Random generator to use.
  */
-void Soldier::trainPsi()
+void Soldier::trainPsi(RNG::RandomState &rng)
 {
 	UnitStats::Type psiSkillCap = _rules->getStatCaps().psiSkill;
 	UnitStats::Type psiStrengthCap = _rules->getStatCaps().psiStrength;
@@ -1348,17 +1351,17 @@ void Soldier::trainPsi()
 	else if (_currentStats.psiSkill <= _rules->getMaxStats().psiSkill)
 	{
 		int max = _rules->getMaxStats().psiSkill + _rules->getMaxStats().psiSkill / 2;
-		_improvement = RNG::generate(_rules->getMaxStats().psiSkill, max);
+		_improvement = rng.generate(_rules->getMaxStats().psiSkill, max);
 	}
 	else
 	{
-		if (_currentStats.psiSkill <= (psiSkillCap / 2)) _improvement = RNG::generate(5, 12);
-		else if (_currentStats.psiSkill < psiSkillCap) _improvement = RNG::generate(1, 3);
+		if (_currentStats.psiSkill <= (psiSkillCap / 2)) _improvement = rng.generate(5, 12);
+		else if (_currentStats.psiSkill < psiSkillCap) _improvement = rng.generate(1, 3);
 
 		if (Options::allowPsiStrengthImprovement)
 		{
-			if (_currentStats.psiStrength <= (psiStrengthCap / 2)) _psiStrImprovement = RNG::generate(5, 12);
-			else if (_currentStats.psiStrength < psiStrengthCap) _psiStrImprovement = RNG::generate(1, 3);
+			if (_currentStats.psiStrength <= (psiStrengthCap / 2)) _psiStrImprovement = rng.generate(5, 12);
+			else if (_currentStats.psiStrength < psiStrengthCap) _psiStrImprovement = rng.generate(1, 3);
 		}
 	}
 	_currentStats.psiSkill = std::max(_currentStats.psiSkill, std::min<UnitStats::Type>(_currentStats.psiSkill+_improvement, psiSkillCap));
@@ -1368,8 +1371,9 @@ void Soldier::trainPsi()
 /**
  * Trains a soldier's Psychic abilities after 1 day.
  * (anytimePsiTraining option)
+ * @param rng Random generator to use.
  */
-void Soldier::trainPsi1Day()
+void Soldier::trainPsi1Day(RNG::RandomState &rng)
 {
 	if (!_psiTraining)
 	{
@@ -1379,7 +1383,7 @@ void Soldier::trainPsi1Day()
 
 	if (_currentStats.psiSkill > 0) // yes, 0. _rules->getMinStats().psiSkill was wrong.
 	{
-		if (8 * 100 >= _currentStats.psiSkill * RNG::generate(1, 100) && _currentStats.psiSkill < _rules->getStatCaps().psiSkill)
+		if (8 * 100 >= _currentStats.psiSkill * rng.generate(1, 100) && _currentStats.psiSkill < _rules->getStatCaps().psiSkill)
 		{
 			++_improvement;
 			++_currentStats.psiSkill;
@@ -1387,7 +1391,7 @@ void Soldier::trainPsi1Day()
 
 		if (Options::allowPsiStrengthImprovement)
 		{
-			if (8 * 100 >= _currentStats.psiStrength * RNG::generate(1, 100) && _currentStats.psiStrength < _rules->getStatCaps().psiStrength)
+			if (8 * 100 >= _currentStats.psiStrength * rng.generate(1, 100) && _currentStats.psiStrength < _rules->getStatCaps().psiStrength)
 			{
 				++_psiStrImprovement;
 				++_currentStats.psiStrength;
@@ -1398,12 +1402,12 @@ void Soldier::trainPsi1Day()
 	{
 		if (++_currentStats.psiSkill == _rules->getMinStats().psiSkill)	// initial training is over
 		{
-			_improvement = _rules->getMaxStats().psiSkill + RNG::generate(0, _rules->getMaxStats().psiSkill / 2);
+			_improvement = _rules->getMaxStats().psiSkill + rng.generate(0, _rules->getMaxStats().psiSkill / 2);
 			_currentStats.psiSkill = _improvement;
 		}
 	}
 	else // minStats.psiSkill <= 0 && _currentStats.psiSkill == minStats.psiSkill
-		_currentStats.psiSkill -= RNG::generate(30, 60);	// set initial training from 30 to 60 days
+		_currentStats.psiSkill -= rng.generate(30, 60);	// set initial training from 30 to 60 days
 }
 
 /**
@@ -1544,27 +1548,29 @@ void Soldier::calcStatString(const std::vector<StatString *> &statStrings, bool
 
 /**
  * Trains a soldier's Physical abilities
+ * @param customTrainingFactor Chance in percent to improve a stat.
+ * @param rng Random generator to use.
  */
-void Soldier::trainPhys(int customTrainingFactor)
+void Soldier::trainPhys(int customTrainingFactor, RNG::RandomState &rng)
 {
 	UnitStats caps1 = _rules->getStatCaps();
 	UnitStats caps2 = _rules->getTrainingStatCaps();
 	// no P.T. for the wounded
 	if (hasFullHealth())
 	{
-		if(_currentStats.firing < caps1.firing && RNG::generate(0, caps2.firing) > _currentStats.firing && RNG::percent(customTrainingFactor))
+		if(_currentStats.firing < caps1.firing && rng.generate(0, caps2.firing) > _currentStats.firing && rng.percent(customTrainingFactor))
 			_currentStats.firing++;
-		if(_currentStats.health < caps1.health && RNG::generate(0, caps2.health) > _currentStats.health && RNG::percent(customTrainingFactor))
+		if(_currentStats.health < caps1.health && rng.generate(0, caps2.health) > _currentStats.health && rng.percent(customTrainingFactor))
 			_currentStats.health++;
-		if(_currentStats.melee < caps1.melee && RNG::generate(0, caps2.melee) > _currentStats.melee && RNG::percent(customTrainingFactor))
+		if(_currentStats.melee < caps1.melee && rng.generate(0, caps2.melee) > _currentStats.melee && rng.percent(customTrainingFactor))
 			_currentStats.melee++;
-		if(_currentStats.throwing < caps1.throwing && RNG::generate(0, caps2.throwing) > _currentStats.throwing && RNG::percent(customTrainingFactor))
+		if(_currentStats.throwing < caps1.throwing && rng.generate(0, caps2.throwing) > _currentStats.throwing && rng.percent(customTrainingFactor))
 			_currentStats.throwing++;
-		if(_currentStats.strength < caps1.strength && RNG::generate(0, caps2.strength) > _currentStats.strength && RNG::percent(customTrainingFactor))
+		if(_currentStats.strength < caps1.strength && rng.generate(0, caps2.strength) > _currentStats.strength && rng.percent(customTrainingFactor))
 			_currentStats.strength++;
-		if(_currentStats.tu < caps1.tu && RNG::generate(0, caps2.tu) > _currentStats.tu && RNG::percent(customTrainingFactor))
+		if(_currentStats.tu < caps1.tu && rng.generate(0, caps2.tu) > _currentStats.tu && rng.percent(customTrainingFactor))
 			_currentStats.tu++;
-		if(_currentStats.stamina < caps1.stamina && RNG::generate(0, caps2.stamina) > _currentStats.stamina && RNG::percent(customTrainingFactor))
+		if(_currentStats.stamina < caps1.stamina && rng.generate(0, caps2.stamina) > _currentStats.stamina && rng.percent(customTrainingFactor))
 			_currentStats.stamina++;
 	}
 }
@@ -1878,6 +1884,8 @@ void Soldier::transform(const Mod *mod, RuleSoldierTransformation *transformatio
 			_transformationBonuses[transformationRule->getSoldierBonusType()] = 1;
 		}
 	}
+
+	resetStatsWithBonuses();
 }
 
 /**
@@ -2027,11 +2035,63 @@ const UnitStats *Soldier::getStatsWithAllBonuses() const
 	return &_tmpStatsWithAllBonuses;
 }
 
+/**
+ * Sums up everything the soldier bonuses come from, so a change
+ * in commendations shows up without anyone having to report it.
+ * @return Key that changes when the bonuses might have.
+ */
+size_t Soldier::getBonusKey() const
+{
+	size_t key = _transformationBonuses.size();
+	for (auto* commendation : *_diary->getSoldierCommendations())
+	{
+		key = key * 31 + (size_t)commendation->getRule() + commendation->getDecorationLevelInt();
+	}
+	return key;
+}
+
+/**
+ * Checks if the stats with bonuses were calculated from
+ * the current stats, armor and bonuses of the soldier.
+ * @param mod Pointer to the mod the bonuses come from.
+ * @return True if they can be used as they are.
+ */
+bool Soldier::hasStatsWithBonuses(const Mod *mod) const
+{
+	if (mod == nullptr || _tmpStatsMod != mod || _tmpStatsArmor != _armor || _tmpStatsBonusKey != getBonusKey())
+	{
+		return false;
+	}
+	bool same = true;
+	UnitStats::fieldLoop(
+		[&](UnitStats::Ptr p)
+		{
+			same = same && (_tmpStatsSource.*p) == (_currentStats.*p);
+		}
+	);
+	return same;
+}
+
+/**
+ * Forces the stats with bonuses to be calculated again next time,
+ * for changes the soldier can't see by itself.
+ */
+void Soldier::resetStatsWithBonuses()
+{
+	_tmpStatsMod = nullptr;
+}
+
 /**
  * Pre-calculates soldier stats with various bonuses.
+ * Nothing is done if nothing they depend on has changed.
  */
 bool Soldier::prepareStatsWithBonuses(const Mod *mod)
 {
+	if (hasStatsWithBonuses(mod))
+	{
+		return _tmpStatsHasSoldierBonus;
+	}
+
 	bool hasSoldierBonus = false;
 
 	// 1. current stats
@@ -2069,6 +2129,13 @@ bool Soldier::prepareStatsWithBonuses(const Mod *mod)
 		_tmpStatsWithSoldierBonuses = _tmpStatsWithAllBonuses;
 	}
 
+	// 8. remember what the stats came from
+	_tmpStatsSource = _currentStats;
+	_tmpStatsArmor = _armor;
+	_tmpStatsMod = mod;
+	_tmpStatsBonusKey = getBonusKey();
+	_tmpStatsHasSoldierBonus = hasSoldierBonus;
+
 	return hasSoldierBonus;
 }
 
@@ -26,6 +26,8 @@
 namespace OpenXcom
 {
 
+namespace RNG { class RandomState; }
+
 enum SoldierRank : char { RANK_ROOKIE, RANK_SQUADDIE, RANK_SERGEANT, RANK_CAPTAIN, RANK_COLONEL, RANK_COMMANDER};
 enum SoldierGender : char { GENDER_MALE, GENDER_FEMALE };
 enum SoldierLook : char { LOOK_BLONDE, LOOK_BROWNHAIR, LOOK_ORIENTAL, LOOK_AFRICAN };
@@ -88,7 +90,15 @@ private:
 	bool _corpseRecovered;
 	std::map<std::string, int> _previousTransformations, _transformationBonuses;
 	std::vector<const RuleSoldierBonus*> _bonusCache;
+	UnitStats _tmpStatsSource;
+	const Armor *_tmpStatsArmor;
+	const Mod *_tmpStatsMod;
+	size_t _tmpStatsBonusKey;
+	bool _tmpStatsHasSoldierBonus;
 	ScriptValues<Soldier> _scriptValues;
+
+	/// Sums up what the soldier bonuses depend on.
+	size_t getBonusKey() const;
 public:
 	/// Creates a new soldier.
 	Soldier(RuleSoldier *rules, Armor *armor, int nationality, int id = 0);
@@ -238,9 +248,9 @@ public:
 	void setPersonalEquipmentArmor(const Armor* armor) { _personalEquipmentArmor = armor; }
 
 	/// Trains a soldier's psychic stats
-	void trainPsi();
+	void trainPsi(RNG::RandomState &rng);
 	/// Trains a soldier's psionic abilities (anytimePsiTraining option).
-	void trainPsi1Day();
+	void trainPsi1Day(RNG::RandomState &rng);
 	/// Is the soldier already fully psi-trained?
 	bool isFullyPsiTrained();
 	/// Returns whether the unit is in psi training or not
@@ -264,7 +274,7 @@ public:
 	/// Calculate statString.
 	void calcStatString(const std::vector<StatString *> &statStrings, bool psiStrengthEval);
 	/// Trains a soldier's physical stats
-	void trainPhys(int customTrainingFactor);
+	void trainPhys(int customTrainingFactor, RNG::RandomState &rng);
 	/// Is the soldier already fully trained?
 	bool isFullyTrained() const;
 	/// Returns whether the unit is in training or not
@@ -293,6 +303,10 @@ public:
 	const UnitStats *getStatsWithAllBonuses() const;
 	/// Pre-calculates soldier stats with various bonuses.
 	bool prepareStatsWithBonuses(const Mod *mod);
+	/// Are the stats with bonuses up to date?
+	bool hasStatsWithBonuses(const Mod *mod) const;
+	/// Forces the stats with bonuses to be calculated again.
+	void resetStatsWithBonuses();
 	/// Gets a pointer to the daily dogfight experience cache.
 	UnitStats* getDailyDogfightExperienceCache();
 	/// Resets the daily dogfight experience cache.
@@ -115,6 +115,7 @@ void Tile::load(const YAML::Node &node)
 	{
 		_animationOffset = RNG::seedless(0, 3);
 	}
+	updateHotEnvironment();
 }
 
 /**
@@ -146,6 +147,7 @@ void Tile::loadBinary(Uint8 *buffer, Tile::SerializationKey& serKey)
 	{
 		_animationOffset = RNG::seedless(0, 3);
 	}
+	updateHotEnvironment();
 }
 
 
@@ -260,6 +262,7 @@ void Tile::setMapData(MapData *dat, int mapDataID, int mapDataSetID, TilePart pa
 			(_objects[O_OBJECT] && _objects[O_OBJECT]->isGravLift())
 		);
 	}
+	updateHotTerrain();
 	updateSprite(part);
 }
 
@@ -451,6 +454,7 @@ bool Tile::isDiscovered(TilePart part) const
 void Tile::resetLight(LightLayers layer)
 {
 	_light[layer] = 0;
+	getHotData().light[getHotIndex()][layer] = 0;
 }
 
 /**
@@ -459,9 +463,11 @@ void Tile::resetLight(LightLayers layer)
  */
 void Tile::resetLightMulti(LightLayers layer)
 {
+	auto& hotLight = getHotData().light[getHotIndex()];
 	for (int l = layer; l < LL_MAX; l++)
 	{
 		_light[l] = 0;
+		hotLight[l] = 0;
 	}
 }
 
@@ -473,7 +479,10 @@ void Tile::resetLightMulti(LightLayers layer)
 void Tile::addLight(int light, LightLayers layer)
 {
 	if (_light[layer] < light)
+	{
 		_light[layer] = light;
+		getHotData().light[getHotIndex()][layer] = light;
+	}
 }
 
 /**
@@ -676,6 +685,7 @@ void Tile::ignite(int power)
 				_overlaps = 1;
 				_fire = getFuel() + 1;
 				_animationOffset = RNG::generate(0,3);
+				updateHotEnvironment();
 			}
 		}
 	}
@@ -755,6 +765,7 @@ void Tile::setFire(int fire)
 {
 	_fire = Clamp(fire, 0, 255);
 	_animationOffset = RNG::generate(0,3);
+	updateHotEnvironment();
 }
 
 /**
@@ -784,6 +795,7 @@ void Tile::addSmoke(int smoke)
 		}
 		_animationOffset = RNG::generate(0,3);
 		addOverlap();
+		updateHotEnvironment();
 	}
 }
 
@@ -795,6 +807,7 @@ void Tile::setSmoke(int smoke)
 {
 	_smoke = Clamp(smoke, 0, 255);
 	_animationOffset = RNG::generate(0,3);
+	updateHotEnvironment();
 }
 
 
@@ -924,6 +937,7 @@ void Tile::prepareNewTurn(bool smokeDamage)
 	if ( _overlaps != 0 && _smoke != 0 && _fire == 0)
 	{
 		_smoke = Clamp((_smoke / _overlaps) - 1, 0, 15);
+		updateHotEnvironment();
 	}
 	// if we still have smoke/fire
 	if (_smoke)
@@ -1088,6 +1102,48 @@ void Tile::resetObstacle(void)
 	_obstacle = 0;
 }
 
+/**
+ * Gets mirror of hot fields of all tiles, owned by battle save.
+ * @return Hot data arrays.
+ */
+TileHotData& Tile::getHotData()
+{
+	return _save->getTileHotData();
+}
+
+/**
+ * Gets index of this tile in mirror arrays.
+ * @return Tile index.
+ */
+int Tile::getHotIndex() const
+{
+	return _save->getTileIndex(_pos);
+}
+
+/**
+ * Update mirrored fire and smoke values.
+ */
+void Tile::updateHotEnvironment()
+{
+	auto& hot = getHotData();
+	const auto index = getHotIndex();
+	hot.fire[index] = _fire;
+	hot.smoke[index] = _smoke;
+}
+
+/**
+ * Update mirrored terrain level and floor flag.
+ */
+void Tile::updateHotTerrain()
+{
+	auto& hot = getHotData();
+	const auto index = getHotIndex();
+	Uint8 flags = 0;
+	if (_cache.isNoFloor) flags |= THF_NO_FLOOR;
+	hot.flags[index] = flags;
+	hot.terrainLevel[index] = _cache.terrainLevel;
+}
+
 
 ////////////////////////////////////////////////////////////
 //					Script binding
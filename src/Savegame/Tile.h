@@ -18,6 +18,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <vector>
+#include <array>
 #include <memory>
 #include "../Engine/Surface.h"
 #include "../Battlescape/Position.h"
@@ -47,6 +48,59 @@ enum TileUnitOverlapping : int
 	TUO_ALWAYS = 0,
 };
 
+/**
+ * Bits of `TileHotData::flags`.
+ */
+enum TileHotFlags : Uint8
+{
+	THF_NO_FLOOR = 1 << 0,
+};
+
+/**
+ * Hot fields of all tiles mirrored in contiguous arrays indexed by `SavedBattleGame::getTileIndex`.
+ * Map wide scans (lighting, smoke and fire, pathfinding) can read them without pulling whole `Tile` objects through cache.
+ * Values are only written by `Tile` setters, everything else should treat it as read only.
+ */
+struct TileHotData
+{
+	std::vector<std::array<Uint8, LL_MAX>> light;
+	std::vector<Uint8> fire;
+	std::vector<Uint8> smoke;
+	std::vector<Sint8> terrainLevel;
+	std::vector<Uint8> flags;
+
+	/// Resize arrays to new map size and set default values of empty tile.
+	void reset(int size)
+	{
+		light.assign(size, { });
+		fire.assign(size, 0);
+		smoke.assign(size, 0);
+		terrainLevel.assign(size, 0);
+		flags.assign(size, THF_NO_FLOOR);
+	}
+
+	/// Get max light of tile from all layers up to given one.
+	int getLightMulti(int index, LightLayers layer) const
+	{
+		const auto& l = light[index];
+		int result = 0;
+		for (int i = layer; i >= 0; --i)
+		{
+			if (l[i] > result)
+			{
+				result = l[i];
+			}
+		}
+		return result;
+	}
+
+	/// Check if tile have given flag set.
+	bool hasFlag(int index, TileHotFlags flag) const
+	{
+		return flags[index] & flag;
+	}
+};
+
 /**
  * Basic element of which a battle map is build.
  * @sa http://www.ufopaedia.org/index.php?title=MAPS
@@ -131,6 +185,14 @@ protected:
 	Sint8 _preview = -1;
 	Uint8 _overlaps = 0;
 
+	/// Gets mirror of hot fields of all tiles.
+	TileHotData& getHotData();
+	/// Gets index of this tile in mirror arrays.
+	int getHotIndex() const;
+	/// Update mirrored fire and smoke.
+	void updateHotEnvironment();
+	/// Update mirrored terrain level and floor flag.
+	void updateHotTerrain();
 
 public:
 	/// Creates a tile.
@@ -79,7 +79,7 @@ bool Transfer::load(const YAML::Node& node, Base *base, const Mod *mod, SavedGam
 		std::string type = craft["type"].as<std::string>();
 		if (mod->getCraft(type) != 0)
 		{
-			_craft = new Craft(mod->getCraft(type), base);
+			_craft = new Craft(mod->getCraft(type), mod, base);
 			_craft->load(craft, mod->getScriptGlobal(), mod, 0);
 		}
 		else
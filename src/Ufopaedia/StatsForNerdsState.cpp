@@ -458,7 +458,7 @@ void StatsForNerdsState::btnPreviewClick(Action *)
 	}
 	// and finally create the craft we need
 	RuleCraft* craftRule = mod->getCraft(_topicId);
-	Craft* c = new Craft(craftRule, base, RuleCraft::DUMMY_CRAFT_ID); // a negative integer
+	Craft* c = new Craft(craftRule, _game->getMod(), base, RuleCraft::DUMMY_CRAFT_ID); // a negative integer
 	base->getCrafts()->push_back(c);
 	c->setName(tr(craftRule->getType()));
 	int max = craftRule->getMaxUnits();
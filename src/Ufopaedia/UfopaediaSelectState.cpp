@@ -218,7 +218,6 @@ namespace OpenXcom
 		Ufopaedia::list(_game->getSavedGame(), _game->getMod(), _section, _article_list);
 		_filtered_article_list.clear();
 
-		int row = 0;
 		bool hasUnseen = false;
 		for (auto* articleDef : _article_list)
 		{
@@ -253,7 +252,6 @@ namespace OpenXcom
 			}
 
 			_filtered_article_list.push_back(articleDef);
-			_lstSelection->addRow(1, tr(articleDef->getMainTitle()).c_str());
 
 			if (markAllAsSeen)
 			{
@@ -262,12 +260,10 @@ namespace OpenXcom
 			}
 			else if (_game->getSavedGame()->getUfopediaRuleStatus(articleDef->id) == ArticleDefinition::PEDIA_STATUS_NEW)
 			{
-				// highlight as new
-				_lstSelection->setCellColor(row, 0, _colorNew);
 				hasUnseen = true;
 			}
-			row++;
 		}
+		_lstSelection->setRowProvider(this, (TextListRowProvider)&UfopaediaSelectState::provideArticleRow, _filtered_article_list.size());
 
 		if (isCommendationsSection)
 		{
@@ -285,4 +281,21 @@ namespace OpenXcom
 		}
 	}
 
+	/**
+	 * Fills a single row of the article list, the list
+	 * only asks for rows that are about to be shown.
+	 * @param row Row number.
+	 * @param cells Texts of the row.
+	 */
+	void UfopaediaSelectState::provideArticleRow(size_t row, std::vector<Text*> &cells)
+	{
+		ArticleDefinition *articleDef = _filtered_article_list[row];
+		cells[0]->setText(tr(articleDef->getMainTitle()));
+		if (_game->getSavedGame()->getUfopediaRuleStatus(articleDef->id) == ArticleDefinition::PEDIA_STATUS_NEW)
+		{
+			// highlight as new
+			cells[0]->setColor(_colorNew);
+		}
+	}
+
 }
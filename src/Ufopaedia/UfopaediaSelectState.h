@@ -68,5 +68,7 @@ namespace OpenXcom
 		void btnMarkAllAsSeenClick(Action *action);
 		/// load available articles into the selection list
 		void loadSelectionList(bool markAllAsSeen);
+		/// Fills a single row of the article list.
+		void provideArticleRow(size_t row, std::vector<Text*> &cells);
 	};
 }
@@ -27,6 +27,8 @@
 #include "Engine/Options.h"
 #include "Engine/FileMap.h"
 #include "Menu/StartState.h"
+#include "Battlescape/BattleBenchmark.h"
+#include "Geoscape/CampaignSimulator.h"
 #include "Engine/Collections.h"
 
 /** @mainpage
@@ -119,8 +121,32 @@ int main(int argc, char *argv[])
 	Options::baseXResolution = Options::displayWidth;
 	Options::baseYResolution = Options::displayHeight;
 
+	if (!Options::getBenchmarkSave().empty() || !Options::getSimulateSave().empty())
+	{
+		// the benchmark and the simulator only drive the engine, no window or sound needed
+		SDL_putenv((char *)"SDL_VIDEODRIVER=dummy");
+		SDL_putenv((char *)"SDL_AUDIODRIVER=dummy");
+		Options::useOpenGL = false;
+	}
+
 	game = new Game(title.str());
 	State::setGamePtr(game);
+	if (!Options::getBenchmarkSave().empty())
+	{
+		BattleBenchmark benchmark(game, Options::getBenchmarkSave(), Options::getBenchmarkTurns(), Options::getBenchmarkSeed());
+		int result = benchmark.run();
+		delete game;
+		FileMap::clear(true, false);
+		return result;
+	}
+	if (!Options::getSimulateSave().empty())
+	{
+		CampaignSimulator simulator(game, Options::getSimulateSave(), Options::getSimulateMonths(), Options::getSimulateSeed(), Options::getSimulateCompare());
+		int result = simulator.run();
+		delete game;
+		FileMap::clear(true, false);
+		return result;
+	}
 	game->setState(new StartState);
 	game->run();
 